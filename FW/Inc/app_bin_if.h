@@ -0,0 +1,116 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup Application
+ * @{
+ * @file			app_bin_if.h
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Binary framed protocol for application communication.
+ * @details			Frames are selected by a start byte that is never sent by
+ * 					the ASCII shell so both protocols can share a UART.
+ *
+ * 					Request and response frames have the same layout, all
+ * 					multibyte values are little endian:
+ * 					| SOF | SEQ | LEN (2) | PAYLOAD (LEN) | CRC (2) |
+ *
+ * 					The CRC is CRC-16/CCITT-FALSE over SEQ, LEN and PAYLOAD.
+ * 					The first payload byte is the command, responses echo the
+ * 					command and sequence number followed by the result and
+ * 					any data.
+ ******************************************************************************
+ */
+
+#ifndef APP_BIN_IF_H_
+#define APP_BIN_IF_H_
+
+/* Defines ********************************************************************/
+/** @brief   Start of frame byte, outside of the ASCII range of the shell */
+#define BIN_SOF				(0xA5)
+
+/** @brief   Size of the start byte, sequence number and length */
+#define BIN_HDR_SIZE		(4)
+
+/** @brief   Size of the frame CRC */
+#define BIN_CRC_SIZE		(2)
+
+/** @brief   Bytes of a frame that are not payload */
+#define BIN_FRAME_OVERHEAD	(BIN_HDR_SIZE + BIN_CRC_SIZE)
+
+/** @brief   Size of the command and result at the start of a response */
+#define BIN_RESP_HDR_SIZE	(2)
+
+/* Enums **********************************************************************/
+/** @brief   Commands for the binary protocol */
+enum BIN_CMD {
+	BIN_CMD_READ_REG = 0x01, /**< index(2), size(2) -> data(size) */
+	BIN_CMD_WRITE_REG = 0x02, /**< index(2), data(n) */
+	BIN_CMD_EXECUTE = 0x03, /**< Executes and commits register changes */
+	BIN_CMD_DUMP_TRACE = 0x04, /**< [start(2), [since(4)]] -> total(2), records */
+	BIN_CMD_READ_REGS = 0x05, /**< [index(2), size(2)] ... -> data */
+	BIN_CMD_DRAIN_TRACE = 0x06, /**< ack(2) -> pos(2), pending(2), records */
+	BIN_CMD_DRAIN_SPI_SNIFF = 0x07, /**< ack(2) -> pos(2), pending(2), frames */
+};
+
+/* Function prototypes ********************************************************/
+/**
+ * @brief Checks if a buffer holds the start of a binary frame.
+ *
+ * @param[in]	frame		Buffer with received bytes
+ *
+ * @return 		1 if the buffer starts with a binary frame
+ */
+uint8_t is_bin_frame(const uint8_t *frame);
+
+/**
+ * @brief Gets the total size of the frame being received.
+ *
+ * @param[in]	frame		Buffer with received bytes
+ * @param[in]	rx_amount	Amount of bytes already received
+ *
+ * @return 		0 if the header is not yet complete
+ * @return 		The total frame size including header and CRC
+ */
+uint32_t bin_frame_size(const uint8_t *frame, uint16_t rx_amount);
+
+/**
+ * @brief Parses a binary frame, executes it and builds the response in place.
+ *
+ * @param[in, out]	frame		Buffer with the frame, holds the response after
+ * @param[in]		buf_size	The max size of the frame buffer
+ * @param[out]		size		The size of the response frame
+ * @param[in]		access		The callers access level
+ *
+ * @return 		0 on success
+ * @return 		EBADMSG CRC or framing error
+ * @return 		EPROTONOSUPPORT command not supported
+ * @return 		EACCES caller doesn't have access
+ * @return 		EMSGSIZE message size too big
+ * @return 		EOVERFLOW invalid address
+ * @return 		ERANGE response does not fit in buffer
+ * @return 		ENODATA not enough data
+ *
+ * @warning		May protect interrupts and cause jitter.
+ */
+error_t parse_frame(uint8_t *frame, uint16_t buf_size, uint16_t *size,
+		uint8_t access);
+
+/**
+ * @brief Calculates the CRC-16/CCITT-FALSE used for frames.
+ *
+ * @param[in]	data		Data to calculate the CRC over
+ * @param[in]	size		Amount of bytes
+ *
+ * @return 		The CRC
+ */
+uint16_t bin_crc16(const uint8_t *data, uint32_t size);
+
+#endif /* APP_BIN_IF_H_ */
+/** @} */
@@ -47,16 +47,6 @@
  */
 void delay_us(uint16_t micros);
 
-/**
- * @brief		Copies and compares data until copied data matches.
- *
- * @param[out]	dest	Destination address to copy to
- * @param[in]	src		Source address to copy
- * @param[in]	size	Size of bytes to copy
- * @note		Used for data concurrency issues without blocking interrupts.
- */
-void copy_until_same(void *dest, void *src, size_t size);
-
 /** @brief	Wrapper function to provide software reset. */
 void soft_reset();
 
@@ -73,5 +63,15 @@ uint32_t get_tick32();
  */
 uint32_t get_tick32_div(uint8_t div);
 
+/**
+ * @brief		Gets 64 bit tick shifted down by an amount.
+ *
+ * @param[in]	div		Divisor, divide ticks by 2^n
+ *
+ * @note		Only correct in interrupts with the same priority as the
+ * 				systick, like get_tick32_div().
+ */
+uint64_t get_tick64_div(uint8_t div);
+
 #endif /* APP_COMMON_H_ */
 /** @} */
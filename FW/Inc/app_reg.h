@@ -22,6 +22,34 @@
 #ifndef APP_REG_H_
 #define APP_REG_H_
 
+/* Defines ********************************************************************/
+/** @brief	Max amount of index and size pairs for read_regs_list() */
+#define READ_REGS_MAX_SPANS		(32)
+
+/**
+ * @brief	Marks a register group as changed by an interrupt.
+ * @note	Must be done after the last write of every interrupt that writes to
+ * 			the group, reads overlapping the group are retried if it changed.
+ */
+#define REG_SNAP_CHANGED(group)	(reg_snap_seq[(group)]++)
+
+/* Enums **********************************************************************/
+/** @brief	Register groups that are written from interrupts */
+enum REG_SNAP {
+	REG_SNAP_USER, /**< user_reg, written by the DUT through write_regs() */
+	REG_SNAP_I2C, /**< i2c_t, written from the DUT I2C interrupts */
+	REG_SNAP_SPI, /**< spi_t, written from the DUT SPI and NSS interrupts */
+	REG_SNAP_UART, /**< uart_t, written from the DUT UART and CTS interrupts */
+	REG_SNAP_TRACE, /**< trace_t, written from the DEBUG pin interrupts */
+	REG_SNAP_PROF, /**< prof_t, written from profiled interrupts */
+	REG_SNAP_TMR, /**< tmr_t, multi word statistics of the dut_ic poll */
+	REG_SNAP_NUMOF /**< Amount of register groups */
+};
+
+/* Global variables ***********************************************************/
+/** @brief	Change counters of the register groups, see REG_SNAP_CHANGED() */
+extern volatile uint32_t reg_snap_seq[REG_SNAP_NUMOF];
+
 /* Function prototypes ********************************************************/
 /**
  * @brief		Initializes application registers.
@@ -34,9 +62,12 @@ void init_app_reg(map_t *reg);
 /**
  * @brief		Executes or commits all register changes on the periphs.
  *
+ * A periph that is busy because another one holds its dma channel or timer
+ * is committed again after all others released what they hold.
+ *
  * @pre			All initializations must be called first.
  * @return      0 if success
- * @return      ERRNO error code
+ * @return      EBUSY a periph still needs a channel or timer that is in use
  */
 error_t execute_reg_change();
 
@@ -86,11 +117,33 @@ error_t read_reg(uint32_t index, uint8_t *data);
  * @return      0 on success
  * @return      EOVERFLOW if trying to read out of range
  *
+ * @note		The copy is retried if an interrupt changes an overlapping
+ * 				register group, after a few tries it is done with interrupts
+ * 				disabled so the time is bounded.
  * @warning		Multiple writes to data may occur so don't pass hardware
  * 				register addresses.
  */
 error_t read_regs(uint32_t index, uint8_t *data, uint16_t size);
 
+/**
+ * @brief		Reads several ranges of the register map one after another.
+ *
+ * @param[in]	spans		Index and size pairs of the ranges to read
+ * @param[in]	count		The amount of pairs
+ * @param[out]	data		Pointer to data that was read
+ * @param[in]	max_size	The max amount of bytes that fit in data
+ * @param[out]	size		The amount of bytes read
+ *
+ * @return      0 on success
+ * @return      EOVERFLOW if trying to read out of range
+ * @return      ERANGE if the data does not fit
+ *
+ * @note		Nothing is read unless all ranges are valid, all ranges are
+ * 				read as one consistent snapshot.
+ */
+error_t read_regs_list(const uint16_t *spans, uint16_t count, uint8_t *data,
+		uint16_t max_size, uint16_t *size);
+
 /**
  * @brief		Writes a register from the register map.
  *
@@ -35,6 +35,7 @@ void init_gpio(map_t *reg);
  * @pre			gpio must first be initialized with init_gpio()
  * @return      0 if OK
  * @return      EINVAL if invalid setting
+ * @return      EBUSY if the capture timer is used by the SPI clock capture
  *
  * @note		Only executes actions if the gpio[x].mode.init is clear.
  */
@@ -45,6 +46,21 @@ error_t commit_debug();
  */
 void update_debug_inputs();
 
+/**
+ * @brief		Merges the edges captured by the timer into the trace.
+ *
+ * Each pin buffers 64 edges, further edges are lost until it is called.
+ * Captured edges are stored without the tick divisor.
+ */
+void poll_debug_ic();
+
+/**
+ * @brief		Gets how full the fullest DEBUG pin edge buffer is.
+ *
+ * @return		Edges waiting for poll_debug_ic() in percent of the buffer
+ */
+uint8_t get_debug_ic_fill();
+
 
 /**
  * @brief		Initializes a basic gpio.
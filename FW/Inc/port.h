@@ -93,8 +93,6 @@
 /* CPU Macros *****************************************************************/
 /******************************************************************************/
 #define TIMER_REMAINING_BUF(x)	(x.Instance->CNDTR)
-#define DUT_IC_OV_OCCURED(x)	(x->Instance->SR & TIM_SR_UIF)
-#define DUT_IC_OV_CLEAR(x)		x->Instance->SR &= ~(TIM_SR_UIF)
 
 #define ADC_DATA_READY(x)	(x.Instance->SR & ADC_FLAG_EOC)
 
@@ -108,6 +108,25 @@
 #define GPIO_DEBUG2_INT			EXTI2_IRQHandler
 #define GPIO_DEBUG2_IRQ			EXTI2_IRQn
 
+/* DEBUG0-2 are channel 1-3 of the timer without a remap, the timer is shared
+ * with the SPI clock capture */
+#define DEBUG_IC_INST			TIM2
+#define DEBUG_IC_CLK_EN()		__HAL_RCC_TIM2_CLK_ENABLE()
+#define DEBUG_IC_CLK_DIS()		__HAL_RCC_TIM2_CLK_DISABLE()
+#define DEBUG_IC_AFIO_REMAP()	__HAL_AFIO_REMAP_TIM2_DISABLE()
+#define DEBUG_IC_INT			TIM2_IRQHandler
+#define DEBUG_IC_IRQ			TIM2_IRQn
+
+/* DEBUG2 is captured by dma, channel 3 latches the rising and channel 4 the
+ * falling edges of the pin, the dma of channel 4 is the one of the SPI clock
+ * capture */
+#define DEBUG_IC_DMA_PIN		(2)
+#define DEBUG_IC_RISE_DMA_INST	DMA1_Channel1
+#define DEBUG_IC_FALL_DMA_INST	DMA1_Channel7
+#define DEBUG_IC_DMA_INT		DMA1_Channel1_IRQHandler
+#define DEBUG_IC_DMA_IRQ		DMA1_Channel1_IRQn
+#define DEBUG_IC_DMA_FLAGS		DMA_IFCR_CGIF1
+
 #define GPIO_NSS_CTS_INT		EXTI15_10_IRQHandler
 #define GPIO_NSS_CTS_IRQ		EXTI15_10_IRQn
 
@@ -147,6 +166,16 @@
 #define DUT_SPI_IC_DMA_INT		DMA1_Channel7_IRQHandler
 #define DUT_SPI_IC_DMA_IRQ		DMA1_Channel7_IRQn
 
+/* The SPI1 requests are fixed, the rx channel is shared with DUT_IC and the
+ * tx channel with the DUT_UART rx, the spi handler of the tx channel passes
+ * the interrupt on while the spi does not hold the channel */
+#define DUT_SPI_RX_DMA_INST		DMA1_Channel2
+#define DUT_SPI_TX_DMA_INST		DMA1_Channel3
+#define DUT_SPI_TX_DMA_INT		DMA1_Channel3_IRQHandler
+#define DUT_SPI_TX_DMA_IRQ		DMA1_Channel3_IRQn
+#define DUT_SPI_TX_DMA_FLAGS	DMA_IFCR_CGIF3
+#define DUT_SPI_TX_DMA_SHARED
+
 /******************************************************************************/
 /* I2C defines ****************************************************************/
 /******************************************************************************/
@@ -178,7 +207,7 @@
 #define GPIO_CTS_IRQ			GPIO_NSS_CTS_IRQ
 
 #define DUT_UART_RX_DMA_INST	DMA1_Channel3
-#define DUT_UART_DMA_RX_INT		DMA1_Channel3_IRQHandler
+#define DUT_UART_DMA_RX_INT		dut_uart_dma_rx_int
 #define DUT_UART_DMA_RX_IRQ		DMA1_Channel3_IRQn
 
 /******************************************************************************/
@@ -230,6 +259,24 @@
 #define DUT_IC_DMA_INT			DMA1_Channel2_IRQHandler
 #define DUT_IC_DMA_IRQ			DMA1_Channel2_IRQn
 
+/* Overflow marks use a compare channel without output since the dma channel
+ * of the update event is used by the IF uart */
+#define DUT_IC_MARK_CHANNEL		TIM_CHANNEL_3
+#define DUT_IC_MARK_DMA_SRC		TIM_DMA_CC3
+#define DUT_IC_MARK_DMA_INST	DMA1_Channel6
+#define DUT_IC_MARK_DMA_INT		DMA1_Channel6_IRQHandler
+#define DUT_IC_MARK_DMA_IRQ		DMA1_Channel6_IRQn
+
+/* The cascade counts the lower 16 bits and clocks DUT_IC_INST with its update,
+ * it captures when DUT_IC_INST signals a capture on its trigger output. It
+ * shares the dma channel with the overflow marks which are not used then. */
+#define DUT_IC_CASCADE_INST			TIM3
+#define DUT_IC_CASCADE_CLK_EN()		__HAL_RCC_TIM3_CLK_ENABLE()
+#define DUT_IC_CASCADE_CLK_DIS()	__HAL_RCC_TIM3_CLK_DISABLE()
+#define DUT_IC_CASCADE_ITR			TIM_TS_ITR2
+#define DUT_IC_CASCADE_TRG			TIM_TS_ITR0
+#define DUT_IC_CASCADE_DMA_INST		DMA1_Channel6
+
 /******************************************************************************/
 /* ADC defines ****************************************************************/
 /******************************************************************************/
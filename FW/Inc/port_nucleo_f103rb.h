@@ -148,6 +148,13 @@
 #define DUT_SPI_IC_DMA_INT		DMA1_Channel7_IRQHandler
 #define DUT_SPI_IC_DMA_IRQ		DMA1_Channel7_IRQn
 
+/* The SPI1 requests are fixed, the rx channel is shared with DUT_IC */
+#define DUT_SPI_RX_DMA_INST		DMA1_Channel2
+#define DUT_SPI_TX_DMA_INST		DMA1_Channel3
+#define DUT_SPI_TX_DMA_INT		DMA1_Channel3_IRQHandler
+#define DUT_SPI_TX_DMA_IRQ		DMA1_Channel3_IRQn
+#define DUT_SPI_TX_DMA_FLAGS	DMA_IFCR_CGIF3
+
 /******************************************************************************/
 /* I2C defines ****************************************************************/
 /******************************************************************************/
@@ -225,9 +232,27 @@
 
 #define DUT_IC_DMA_INT			DMA1_Channel2_IRQHandler
 #define DUT_IC_DMA_IRQ			DMA1_Channel2_IRQn
+
 #define DUT_IC_GPIO_INT			EXTI9_5_IRQHandler
 #define DUT_IC_GPIO_IRQ			EXTI9_5_IRQn
 
+/* Overflow marks use a compare channel without output since the dma channel
+ * of the update event is used by the DUT uart */
+#define DUT_IC_MARK_CHANNEL		TIM_CHANNEL_4
+#define DUT_IC_MARK_DMA_SRC		TIM_DMA_CC4
+#define DUT_IC_MARK_DMA_INST	DMA1_Channel4
+#define DUT_IC_MARK_DMA_INT		DMA1_Channel4_IRQHandler
+#define DUT_IC_MARK_DMA_IRQ		DMA1_Channel4_IRQn
+
+/* The cascade counts the lower 16 bits and clocks DUT_IC_INST with its update,
+ * it captures when DUT_IC_INST signals a capture on its trigger output */
+#define DUT_IC_CASCADE_INST			TIM4
+#define DUT_IC_CASCADE_CLK_EN()		__HAL_RCC_TIM4_CLK_ENABLE()
+#define DUT_IC_CASCADE_CLK_DIS()	__HAL_RCC_TIM4_CLK_DISABLE()
+#define DUT_IC_CASCADE_ITR			TIM_TS_ITR3
+#define DUT_IC_CASCADE_TRG			TIM_TS_ITR0
+#define DUT_IC_CASCADE_DMA_INST		DMA1_Channel1
+
 /******************************************************************************/
 /* ADC defines ****************************************************************/
 /******************************************************************************/
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup Application
+ * @{
+ * @file			prof.h
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Cycle count profiling of hot paths.
+ * @details			Only compiled in with PHILIP_PROFILE (make PROFILE=1),
+ * 					otherwise the profiling macros are empty. The DWT cycle
+ * 					counter of each call is aggregated into the prof
+ * 					registers.
+ ******************************************************************************
+ */
+
+#ifndef PROF_H_
+#define PROF_H_
+
+/* Enums **********************************************************************/
+/** @brief	Profiled functions, the index of the prof.entry registers */
+enum PROF_ID {
+	PROF_PARSE_COMMAND, /**< parse_command() of the shell */
+	PROF_PARSE_FRAME, /**< parse_frame() of the binary protocol */
+	PROF_FLUSH_TMR_BUF, /**< Flushing the DUT_IC DMA buffer */
+	PROF_POLL_DUT_SPI_IC, /**< poll_dut_spi_ic() */
+	PROF_I2C_IT, /**< DUT I2C event interrupt */
+	PROF_SPI_REG_INT, /**< DUT SPI register mode interrupt */
+};
+
+/* Defines ********************************************************************/
+#ifdef PHILIP_PROFILE
+/** @brief	Starts profiling a call, must be in the same scope as PROF_END() */
+#define PROF_START(id)	uint32_t _prof_start_##id = PROF_CYCLES()
+
+/** @brief	Records the cycles since PROF_START() of the same id */
+#define PROF_END(id)	record_prof((id), PROF_CYCLES() - _prof_start_##id)
+#else
+/** @brief	Profiling disabled */
+#define PROF_START(id)
+
+/** @brief	Profiling disabled */
+#define PROF_END(id)
+#endif
+
+#ifndef PROF_CYCLES
+/** @brief	Reads the cycle counter, can be replaced for host builds */
+#define PROF_CYCLES()	(DWT->CYCCNT)
+#endif
+
+/* Function prototypes ********************************************************/
+/**
+ * @brief		Initializes profiling and starts the cycle counter.
+ *
+ * @param[in]	reg			Pointer to register memory map
+ *
+ * @note		Does nothing unless built with PHILIP_PROFILE.
+ */
+void init_prof(map_t *reg);
+
+/**
+ * @brief		Records the cycles of a call.
+ *
+ * @param[in]	id			The profiled function, see PROF_ID
+ * @param[in]	cycles		The cycles the call took
+ */
+void record_prof(uint8_t id, uint32_t cycles);
+
+/**
+ * @brief		Adds the cycles of a call to a profile entry.
+ *
+ * @param[in, out]	entry		The profile entry to update
+ * @param[in]		cycles		The cycles the call took
+ *
+ * @note		An entry with a call count of 0 is restarted so writing 0 to
+ * 				the call count register resets it.
+ */
+void update_prof_entry(prof_entry_t *entry, uint32_t cycles);
+
+#endif /* PROF_H_ */
+/** @} */
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup Application
+ * @{
+ * @file			sched.h
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Cooperative task scheduler for the polling functions.
+ * @details			Each pass runs the most urgent periodic task that is due
+ * 					followed by all tasks without a period. The run count and
+ * 					worst case runtime of every task are kept in the register
+ * 					map. Tasks cannot be preempted so a budget is not enforced,
+ * 					instead drains with a buffer filled past SCHED_BOOST_FILL
+ * 					run again after every task until it empties.
+ ******************************************************************************
+ */
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+/* Defines ********************************************************************/
+/** @brief	Fill in percent from which a drain runs between all other tasks */
+#define SCHED_BOOST_FILL	(50)
+
+/* Enums/structs **************************************************************/
+/** @brief	A task run by the scheduler */
+typedef struct {
+	void (*fxn)(void); /**< Function to run */
+	uint16_t period; /**< Time between runs in ms, 0 runs on every pass */
+	uint8_t priority; /**< Lower values run first if several tasks are due */
+	uint16_t budget; /**< Expected worst case runtime in us, 0 is unchecked */
+	/** @brief Fill of the buffer the task drains in percent, NULL if none */
+	uint8_t (*fill)(void);
+} sched_task_t;
+
+/* Function prototypes ********************************************************/
+/**
+ * @brief		Initializes the scheduler.
+ *
+ * @param[in]	reg			Pointer to register memory map
+ * @param[in]	tasks		The tasks to run, the index matches the statistics
+ * 							in the register map
+ * @param[in]	count		The amount of tasks
+ *
+ * @note		Tasks beyond the statistics in the register map are ignored.
+ */
+void init_sched(map_t *reg, const sched_task_t *tasks, uint8_t count);
+
+/**
+ * @brief		Runs one pass of the scheduler.
+ */
+void run_sched();
+
+#endif /* SCHED_H_ */
+/** @} */
@@ -24,6 +24,17 @@
 /** @brief	SPI data not available byte */
 #define SPI_NO_DATA_BYTE	0xFE
 
+/** @brief	Size of the header of a frame from drain_dut_spi_sniff() */
+#define SPI_SNIFF_HDR_SIZE			(18)
+/** @brief	The frame was longer than the sniffer buffer, no data is packed */
+#define SPI_SNIFF_FLAG_OVERFLOW		(0x01)
+/** @brief	MOSI bytes of the frame were overwritten before the drain */
+#define SPI_SNIFF_FLAG_MOSI_LOST	(0x02)
+/** @brief	MISO samples of the frame were overwritten or skipped */
+#define SPI_SNIFF_FLAG_MISO_LOST	(0x04)
+/** @brief	The data did not fit the buffer and was cut */
+#define SPI_SNIFF_FLAG_CUT			(0x08)
+
 /* Function prototypes ********************************************************/
 /**
  * @brief		Initializes spi registers.
@@ -39,6 +50,11 @@ void init_dut_spi(map_t *reg);
  *
  * @pre			spi must first be initialized with init_dut_spi()
  * @return      0 if OK
+ * @return      EBUSY if the clock capture timer captures the DEBUG pins
+ * @return      EBUSY if the dma channels are used by another peripheral
+ * @return      EBUSY if the sniffer cannot claim the clock capture or the
+ * 				receive dma channel
+ * @return      EINVAL if the interface type is unknown
  *
  * @note		Only executes actions if the spi.mode.init is clear.
  */
@@ -71,9 +87,52 @@ void deinit_dut_spi_ic_msp();
 
 /**
  * @brief       Poll for transfers captured by the IC to put them into the buffer
+ *
+ * @details		Measures the bit periods and deadtimes of all captured clock
+ * 				edges, the first edges are also copied to spi.sm_buf.
  */
 void poll_dut_spi_ic();
 
+/**
+ * @brief		Gets how full the clock capture buffer is.
+ *
+ * @return		Edges waiting for poll_dut_spi_ic() in percent of the buffer
+ */
+uint8_t get_dut_spi_ic_fill();
+
+/**
+ * @brief		Advances the clock capture position, call on dma half and
+ * 				complete transfers.
+ */
+void dut_spi_ic_half_cplt();
+
+/**
+ * @brief		Drains the frames recorded by the sniffer oldest first.
+ *
+ * Frames stay in the ring until they are acknowledged so a lost response can
+ * be requested again.  The position counts all drained frames and wraps, the
+ * ack is the position after the last frame that was received.
+ *
+ * Each frame is packed as the tick when NSS lowered (8), the ticks until NSS
+ * raised (4), the size of the frame (2), the amount of packed bytes (2) and
+ * the SPI_SNIFF_FLAG (2) followed by the packed MOSI and then MISO bytes.
+ *
+ * @param[in]	ack			Position of the first frame still needed
+ * @param[out]	buf			Buffer to pack the frames into
+ * @param[in]	max_size	Size of the buffer
+ * @param[out]	size		Amount of bytes packed into the buffer
+ * @param[out]	pos			Position of the first packed frame
+ * @param[out]	pending		Amount of frames in the ring after the ack
+ *
+ * @return		0 success
+ * @return		ERANGE ack is past the recorded frames
+ *
+ * @note		MISO is sampled by the dma of the clock capture so it must stay
+ * 				valid for the dma latency after the sampling edge.
+ */
+error_t drain_dut_spi_sniff(uint16_t ack, uint8_t *buf, uint16_t max_size,
+		uint16_t *size, uint16_t *pos, uint16_t *pending);
+
 /* Interrupts ----------------------------------------------------------------*/
 /**
  * @brief Interrupt callback for the spi line raise or lower
@@ -27,8 +27,18 @@ enum DUT_IC_EDGE {
 	DUT_IC_EDGE_FALLING, /**< Interrupt on falling edge using DMA */
 };
 
+/**
+ * @brief		Differences in the histogram when measuring both edges.
+ */
+enum DUT_IC_HIST {
+	DUT_IC_HIST_ALL, /**< Every difference between edges */
+	DUT_IC_HIST_HIGH, /**< Differences ending with a falling edge */
+	DUT_IC_HIST_LOW, /**< Differences ending with a rising edge */
+};
+
 #define DMA_HOLDOFF_NS		200	/**< Time it takes for a DMA to load value */
 #define INT_HOLDOFF_NS		1000 /**< Time it takes for a interrupt to load value */
+#define CASCADE_HOLDOFF_NS	400 /**< Time it takes for both cascade DMAs to load values */
 
 #define OVERFLOW_TICK_VAL	0x10000 /**< 16 bit timer will overflow to this value */
 /* Function prototypes -------------------------------------------------------*/
@@ -55,6 +65,7 @@ void deinit_dut_ic_msp();
  *
  * @return      0 		success
  * @return      -EINVAL	invalid value
+ * @return      -EBUSY	the capture dma channel is used by the spi
  *
  * @note		Only executes actions if the tmr.mode.init == 0.
  */
@@ -65,10 +76,25 @@ error_t commit_dut_ic();
  *
  * Since values must be transferred before the buffer overflows, either in DMA
  * or INT mode this must be called at a rate faster that buffer overflow can
- * occur.
+ * occur. Edges overwritten before they are read are counted as dropped.
+ * As a frequency counter it ends the gate once tmr.gate_ms passed.
  */
 void poll_dut_ic();
 
+/**
+ * @brief		Gets how full the capture buffer is.
+ *
+ * @return		Edges waiting for poll_dut_ic() in percent of the buffer
+ */
+uint8_t get_dut_ic_fill();
+
+/**
+ * @brief		Hands off a filled half of the capture buffer.
+ *
+ * @note		Only for use with the STM32xxxx_HAL_Driver.
+ */
+void dut_ic_half_cplt();
+
 /**
  * @brief		Updates the dut_ic input level.
  */
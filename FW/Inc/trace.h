@@ -35,6 +35,27 @@ enum EVENT_TYPE {
 	EVENT_TYPE_RISING /**< Rising edge interrupt */
 };
 
+/** @brief  	Condition that starts the capture window. */
+enum TRACE_TRIG {
+	TRACE_TRIG_NONE, /**< No window, all events are traced */
+	TRACE_TRIG_EVENT, /**< An event of trig_source with trig_value */
+	TRACE_TRIG_WRITE, /**< A write by the DUT to trig_addr */
+	TRACE_TRIG_COUNT, /**< The trig_count DUT_IC event */
+	TRACE_TRIG_TICK, /**< The first event from trig_tick */
+	TRACE_TRIG_NUMOF /**< Amount of trigger conditions */
+};
+
+/** @brief  	State of the capture window. */
+enum TRACE_TRIG_STATE {
+	TRACE_TRIG_OFF, /**< No trigger condition */
+	TRACE_TRIG_ARMED, /**< Waiting for the trigger */
+	TRACE_TRIG_RUNNING, /**< Tracing events after the trigger */
+	TRACE_TRIG_DONE /**< The window is full */
+};
+
+/** @brief  	Size of a packed trace record from dump_trace(). */
+#define TRACE_RECORD_SIZE	(16)
+
 /* Function prototypes ********************************************************/
 /**
  * @brief		Initializes trace register.
@@ -44,6 +65,27 @@ enum EVENT_TYPE {
  */
 void init_trace(map_t *reg);
 
+/**
+ * @brief		Commits the trace registers and executes operations.
+ *
+ * Empties the stream ring and resets its statistics. A trigger condition arms
+ * the capture window and clears the trace registers.
+ *
+ * @return		0 success
+ * @return		-EINVAL invalid trigger condition or depth
+ *
+ * @note		Only executes actions if the trace.mode.init == 0.
+ */
+error_t commit_trace();
+
+/**
+ * @brief		Checks how far the stack grew into the guard gap above the ring.
+ *
+ * Updates trace.stack_guard_used. Once the whole gap is used the stream ring
+ * stops so it cannot overwrite the stack, events go to the trace registers.
+ */
+void check_stack_guard();
+
 /**
  * @brief		Stores an gpio toggle event.
  *
@@ -64,7 +106,72 @@ void store_gpio_trace(uint8_t tick_div, uint8_t source, uint16_t value);
  * @param[in]	value		The value from the event
  * @param[in]	tick		Value of the tick
  */
-void store_tick_from_buf(uint8_t source, uint16_t value, uint32_t tick);
+void store_tick_from_buf(uint8_t source, uint16_t value, uint64_t tick);
+
+/**
+ * @brief		Triggers the capture window on writes by the DUT.
+ *
+ * @note		May be called from interrupt context.
+ *
+ * @param[in]	index		The first register written
+ * @param[in]	size		Amount of registers written
+ */
+void trigger_trace_write(uint32_t index, uint16_t size);
+
+/**
+ * @brief		Counts events that were lost before they reached the trace.
+ *
+ * Each lost event takes a sequence number like the events lost in the trace.
+ *
+ * @param[in]	source		The source of the events
+ * @param[in]	amount		Amount of lost events
+ */
+void drop_trace(uint8_t source, uint32_t amount);
+
+/**
+ * @brief		Packs the valid trace entries oldest first.
+ *
+ * Each record is TRACE_RECORD_SIZE bytes of source (1), tick_div (1),
+ * value (2), tick (8) and seq (4) in little endian.  Entries without a
+ * source or older than since are skipped.
+ *
+ * @param[in]	start		Amount of valid entries to skip
+ * @param[in]	since		Sequence number of the oldest entry to pack, NULL to
+ * 							pack all entries
+ * @param[out]	buf			Buffer to pack the records into
+ * @param[in]	max_size	Size of the buffer
+ * @param[out]	total		Amount of valid entries since the sequence number
+ *
+ * @return		Amount of bytes packed into the buffer
+ */
+uint16_t dump_trace(uint16_t start, const uint32_t *since, uint8_t *buf,
+		uint16_t max_size, uint16_t *total);
+
+/**
+ * @brief		Drains events from the stream ring oldest first.
+ *
+ * Events stay in the ring until they are acknowledged so a lost response can
+ * be requested again.  The position counts all drained events and wraps, the
+ * ack is the position after the last event that was received.
+ *
+ * The ring only holds trace.stream_size events, the host must drain it faster
+ * than it fills.  Events that do not fit are counted in trace.dropped by
+ * source and in trace.stream_overruns.
+ *
+ * @param[in]	ack			Position of the first event still needed
+ * @param[out]	buf			Buffer to pack the records into
+ * @param[in]	max_size	Size of the buffer
+ * @param[out]	size		Amount of bytes packed into the buffer
+ * @param[out]	pos			Position of the first packed event
+ * @param[out]	pending		Amount of events in the ring after the ack
+ *
+ * @return		0 success
+ * @return		ERANGE ack is past the queued events
+ *
+ * @note		Records are packed as in dump_trace().
+ */
+error_t drain_trace(uint16_t ack, uint8_t *buf, uint16_t max_size,
+		uint16_t *size, uint16_t *pos, uint16_t *pending);
 
 #endif /* TRACE_H_ */
 /** @} */
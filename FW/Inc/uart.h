@@ -28,6 +28,18 @@
 /** @brief	Size allocated for dut uart buffer */
 #define UART_DUT_BUF_SIZE	(128)
 
+/** @brief	Min baudrate of the interface uart */
+#define IF_UART_MIN_BAUD	(9600)
+
+/** @brief	Max baudrate of the interface uart */
+#define IF_UART_MAX_BAUD	(2000000)
+
+/** @brief	Time in ms to receive a command after changing the if baudrate */
+#define IF_UART_BAUD_TIMEOUT	(1000)
+
+/** @brief	Time in ms without a byte before a partial frame is dropped */
+#define UART_FRAME_TIMEOUT	(50)
+
 
 /* Function prototypes ********************************************************/
 /**
@@ -41,14 +53,31 @@ void init_dut_uart(map_t *reg);
 
 /**
  * @brief		Initializes interface uart registers.
+ *
+ * @param[in]	reg			Pointer to live register memory map
+ */
+void init_if_uart(map_t *reg);
+
+/**
+ * @brief		Changes the baudrate of the interface uart.
+ *
+ * The baudrate changes once the current response is sent.  If no command is
+ * received at the new baudrate within IF_UART_BAUD_TIMEOUT the previous
+ * baudrate is restored.
+ *
+ * @param[in]	baud		The new baudrate
+ *
+ * @return      0 Success
+ * @return 		EINVAL Invalid baudrate
  */
-void init_if_uart();
+error_t set_if_uart_baud(uint32_t baud);
 
 /**
  * @brief		Commits the dut uart registers and executes operations.
  *
  * @pre			uart must first be initialized with init_dut_uart()
  * @return      0 Success
+ * @return      EBUSY if the rx dma channel is used by the spi
  *
  * @note		Only executes actions if the uart.mode.init is set.
  */
@@ -3,7 +3,7 @@
  * @addtogroup philip_map_mmm
  * @{
  * @file      mm_access_philip_map.c
- * @version   2.0.0
+ * @version   2.1.0
  * @}
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -306,6 +306,7 @@ static const mm_access_t _PHILIP_MAP_ACCESS[] =
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* sys.sys_clk */
 {.data=1},  /* sys.status.update */
 {.data=1},  /* sys.mode.init */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sys.if_baud */
 {.data=1},  /* i2c.mode.init */
 {.data=0},  /* i2c.status.ovr */
 {.data=1},  /* i2c.dut_sda.io_type */
@@ -349,7 +350,7 @@ static const mm_access_t _PHILIP_MAP_ACCESS[] =
 {.data=1},  /* i2c.padding[23] */
 {.data=1},  /* i2c.padding[24] */
 {.data=1},  /* i2c.padding[25] */
-{.data=1},  /* spi.mode.init */
+{.data=1}, {.data=1},  /* spi.mode.init */
 {.data=0},  /* spi.status.bsy */
 {.data=1},  /* spi.dut_mosi.io_type */
 {.data=1},  /* spi.dut_miso.io_type */
@@ -428,6 +429,54 @@ static const mm_access_t _PHILIP_MAP_ACCESS[] =
 {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* spi.sm_buf[61] */
 {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* spi.sm_buf[62] */
 {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* spi.sm_buf[63] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_edges */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_lost */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_frames */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_bit_count */
+{.data=0}, {.data=0},  /* spi.sm_bit_min */
+{.data=0}, {.data=0},  /* spi.sm_bit_max */
+{.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_bit_sum */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_dead_count */
+{.data=0}, {.data=0},  /* spi.sm_dead_min */
+{.data=0}, {.data=0},  /* spi.sm_dead_max */
+{.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_dead_sum */
+{.data=0}, {.data=0},  /* spi.sm_frame_bytes */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_frame_freq */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_frame_rate */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[0] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[1] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[2] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[3] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[4] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[5] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[6] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[7] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[8] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[9] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[10] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[11] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[12] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[13] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[14] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[15] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[16] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[17] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[18] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[19] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[20] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[21] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[22] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[23] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[24] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[25] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[26] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[27] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[28] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[29] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[30] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sm_byte_freq[31] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sniff_frames */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* spi.sniff_lost */
 {.data=1}, {.data=1},  /* uart.mode.init */
 {.data=1},  /* uart.dut_rx.io_type */
 {.data=1},  /* uart.dut_tx.io_type */
@@ -513,14 +562,64 @@ static const mm_access_t _PHILIP_MAP_ACCESS[] =
 {.data=0}, {.data=0},  /* tmr.min_holdoff */
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.min_tick */
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.max_tick */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* tmr.hist_start */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* tmr.hist_width */
+{.data=1},  /* tmr.hist_numof */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist_below */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist_above */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[0] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[1] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[2] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[3] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[4] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[5] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[6] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[7] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[8] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[9] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[10] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[11] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[12] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[13] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[14] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[15] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[16] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[17] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[18] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[19] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[20] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[21] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[22] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[23] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[24] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[25] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[26] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[27] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[28] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[29] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[30] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.hist[31] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.stat_count */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.stat_ref */
+{.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.stat_sum */
+{.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.stat_sum_sq */
+{.data=1}, {.data=1},  /* tmr.gate_ms */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.gate_count */
+{.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.gate_tick */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.edge_count */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* tmr.freq */
+{.data=0}, {.data=0},  /* tmr.duty */
 {.data=1}, {.data=1},  /* gpio[0].mode.init */
 {.data=0},  /* gpio[0].status.level */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* gpio[0].capture_lost */
 {.data=1},  /* gpio[0].padding[0] */
 {.data=1}, {.data=1},  /* gpio[1].mode.init */
 {.data=0},  /* gpio[1].status.level */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* gpio[1].capture_lost */
 {.data=1},  /* gpio[1].padding[0] */
 {.data=1}, {.data=1},  /* gpio[2].mode.init */
 {.data=0},  /* gpio[2].status.level */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* gpio[2].capture_lost */
 {.data=1},  /* gpio[2].padding[0] */
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.index */
 {.data=0},  /* trace.tick_div[0] */
@@ -1035,6 +1134,379 @@ static const mm_access_t _PHILIP_MAP_ACCESS[] =
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick[125] */
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick[126] */
 {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick[127] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[0] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[1] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[2] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[3] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[4] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[5] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[6] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[7] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[8] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[9] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[10] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[11] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[12] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[13] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[14] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[15] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[16] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[17] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[18] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[19] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[20] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[21] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[22] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[23] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[24] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[25] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[26] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[27] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[28] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[29] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[30] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[31] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[32] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[33] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[34] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[35] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[36] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[37] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[38] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[39] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[40] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[41] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[42] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[43] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[44] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[45] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[46] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[47] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[48] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[49] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[50] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[51] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[52] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[53] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[54] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[55] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[56] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[57] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[58] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[59] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[60] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[61] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[62] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[63] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[64] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[65] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[66] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[67] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[68] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[69] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[70] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[71] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[72] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[73] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[74] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[75] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[76] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[77] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[78] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[79] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[80] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[81] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[82] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[83] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[84] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[85] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[86] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[87] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[88] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[89] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[90] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[91] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[92] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[93] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[94] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[95] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[96] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[97] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[98] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[99] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[100] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[101] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[102] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[103] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[104] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[105] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[106] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[107] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[108] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[109] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[110] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[111] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[112] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[113] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[114] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[115] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[116] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[117] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[118] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[119] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[120] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[121] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[122] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[123] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[124] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[125] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[126] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.tick_hi[127] */
+{.data=1},  /* trace.mode.init */
+{.data=0}, {.data=0},  /* trace.stream_size */
+{.data=0}, {.data=0},  /* trace.stream_level */
+{.data=0}, {.data=0},  /* trace.stream_high_water */
+{.data=0}, {.data=0},  /* trace.stack_guard_used */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.stream_overruns */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.next_seq */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.count */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[0] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[1] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[2] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[3] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[4] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[5] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[6] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[7] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[8] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[9] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[10] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[11] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[12] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[13] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[14] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[15] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[16] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[17] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[18] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[19] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[20] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[21] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[22] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[23] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[24] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[25] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[26] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[27] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[28] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[29] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[30] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[31] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[32] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[33] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[34] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[35] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[36] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[37] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[38] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[39] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[40] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[41] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[42] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[43] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[44] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[45] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[46] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[47] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[48] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[49] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[50] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[51] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[52] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[53] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[54] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[55] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[56] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[57] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[58] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[59] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[60] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[61] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[62] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[63] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[64] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[65] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[66] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[67] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[68] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[69] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[70] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[71] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[72] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[73] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[74] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[75] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[76] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[77] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[78] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[79] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[80] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[81] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[82] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[83] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[84] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[85] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[86] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[87] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[88] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[89] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[90] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[91] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[92] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[93] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[94] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[95] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[96] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[97] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[98] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[99] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[100] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[101] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[102] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[103] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[104] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[105] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[106] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[107] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[108] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[109] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[110] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[111] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[112] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[113] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[114] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[115] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[116] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[117] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[118] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[119] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[120] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[121] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[122] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[123] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[124] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[125] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[126] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.seq[127] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.dropped[0] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.dropped[1] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.dropped[2] */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.dropped[3] */
+{.data=1},  /* trace.pre_depth */
+{.data=1}, {.data=1},  /* trace.post_depth */
+{.data=1},  /* trace.trig_source */
+{.data=1}, {.data=1},  /* trace.trig_value */
+{.data=1}, {.data=1},  /* trace.trig_addr */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* trace.trig_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* trace.trig_tick */
+{.data=0},  /* trace.trig_state */
+{.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.trig_seq */
+{.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0}, {.data=0},  /* trace.trig_time */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.max_loop_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[0].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[0].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[0].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[1].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[1].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[1].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[2].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[2].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[2].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[3].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[3].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[3].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[4].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[4].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[4].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[5].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[5].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[5].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[6].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[6].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[6].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[7].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[7].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[7].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[8].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[8].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[8].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[9].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[9].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[9].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[10].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[10].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[10].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[11].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[11].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[11].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[12].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[12].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[12].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[13].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[13].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[13].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[14].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[14].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[14].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[15].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[15].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[15].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[16].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[16].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[16].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[17].run_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[17].max_ticks */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* sched.task[17].overruns */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[0].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[0].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[0].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[0].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[0].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[1].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[1].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[1].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[1].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[1].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[2].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[2].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[2].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[2].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[2].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[3].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[3].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[3].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[3].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[3].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[4].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[4].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[4].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[4].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[4].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[5].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[5].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[5].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[5].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[5].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[6].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[6].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[6].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[6].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[6].total_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[7].call_count */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[7].min_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[7].max_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[7].mean_cycles */
+{.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1}, {.data=1},  /* prof.entry[7].total_cycles */
 };
 
 /* functions *****************************************************************/
@@ -3,7 +3,7 @@
  * @addtogroup philip_map_mmm
  * @{
  * @file      mm_access_philip_map.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -3,7 +3,7 @@
  * @addtogroup mmm
  * @{
  * @file      mm_access_types.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
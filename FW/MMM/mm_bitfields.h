@@ -3,7 +3,7 @@
  * @addtogroup bitfields_mmm
  * @{
  * @file      mm_bitfields.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -44,7 +44,8 @@ typedef union {
         uint16_t level: 1; /**< If output sets gpio level - 0:low - 1:high */
         uint16_t pull: 2; /**< pull of the resistor - 0:none - 1:pullup - 2:pulldown */
         uint16_t tick_div: 5; /**< for trace tick divisor - max should be 16 for interface */
-        uint16_t padding: 5; /**< padding bits */
+        uint16_t capture: 1; /**< Edge timestamps in interrupt mode - 0:taken in the pin interrupt - 1:latched by a timer input capture - Capture is only available on the bluepill and uses the timer of the SPI clock capture - DEBUG2 is captured by dma without an interrupt per edge - DEBUG0 and DEBUG1 have no free dma channel and take an interrupt per edge so their edges must be further apart than the interrupt latency - status.capture_dma shows the dma pins and capture_lost the missed edges */
+        uint16_t padding: 4; /**< padding bits */
     };
     uint16_t data; /**< Full bitfield data */
 } gpio_mode_t;
@@ -69,7 +70,8 @@ MM_PACKED_START
 typedef union {
     struct {
         uint8_t level: 1; /**< The io level of the pin - 0:low - 1:high */
-        uint8_t padding: 7; /**< padding bits */
+        uint8_t capture_dma: 1; /**< 1:the edges are captured by dma - 0:the edges are not captured or each edge interrupts */
+        uint8_t padding: 6; /**< padding bits */
     };
     uint8_t data; /**< Full bitfield data */
 } gpio_status_t;
@@ -120,6 +122,19 @@ typedef union {
 } basic_mode_t;
 MM_PACKED_END
 
+MM_PACKED_START
+/** @brief Trace mode settings */
+typedef union {
+    struct {
+        uint8_t init: 1; /**< 0:trace will initialize on execute - 1:trace initialized */
+        uint8_t stream: 1; /**< 0:events overwrite the oldest trace entries - 1:events are queued in the stream ring until the host drains them - The ring is not a stream pushed to the host - It holds stream_size events and the host must drain it faster than events fill it - Events that do not fit are lost and counted in dropped by source and in stream_overruns */
+        uint8_t trig: 3; /**< Condition that starts the capture window - 0:none and all events are traced - 1:event of trig_source with trig_value - 2:write by the DUT to the register at trig_addr - 3:the trig_count DUT_IC event - 4:the first event from trig_tick */
+        uint8_t padding: 3; /**< padding bits */
+    };
+    uint8_t data; /**< Full bitfield data */
+} trace_mode_t;
+MM_PACKED_END
+
 MM_PACKED_START
 /** @brief SPI status */
 typedef union {
@@ -141,15 +156,16 @@ MM_PACKED_START
 /** @brief SPI mode settings */
 typedef union {
     struct {
-        uint8_t init: 1; /**< 0:periph will initialize on execute - 1:periph initialized */
-        uint8_t disable: 1; /**< 0:periph is enabled - 1:periph is disabled */
-        uint8_t cpha: 1; /**< 0:CK to 0 when idle - 1:CK to 1 when idle */
-        uint8_t cpol: 1; /**< 0:the first clock transition is the first data capture edge - 1:the second clock transition is the first data capture edge */
-        uint8_t if_type: 2; /**< Sets spi modes since slave cannot responds immediately - 0:access registers with spi - 1:preloads reg address to 0 for high speed tests - 2:echos SPI bytes - 3:always output user reg 0 (use for timing) */
-        uint8_t reg_16_bit: 1; /**< 0:8 bit register access - 1:16 bit register access mode */
-        uint8_t reg_16_big_endian: 1; /**< 0:little endian for 16 bit mode - 1:big endian for 16 bit mode */
+        uint16_t init: 1; /**< 0:periph will initialize on execute - 1:periph initialized */
+        uint16_t disable: 1; /**< 0:periph is enabled - 1:periph is disabled */
+        uint16_t cpha: 1; /**< 0:CK to 0 when idle - 1:CK to 1 when idle */
+        uint16_t cpol: 1; /**< 0:the first clock transition is the first data capture edge - 1:the second clock transition is the first data capture edge */
+        uint16_t if_type: 3; /**< Sets spi modes since slave cannot responds immediately - 0:access registers with spi - 1:preloads reg address to 0 for high speed tests - 2:echos SPI bytes - 3:always output user reg 0 (use for timing) - 4:captures the spi clock for speed measurement - 5:access registers with dma and apply writes when NSS rises - 6:sniffs the frames of other devices without driving MISO - 5 takes at most 256 bytes after the address and sets ovr if a frame is longer and index_err if it is a write - 5 reads wrap at the end of the map like 0 - 5 and 6 are busy until tmr is disabled and 5 on the bluepill also until uart is disabled since they share dma channels */
+        uint16_t reg_16_bit: 1; /**< 0:8 bit register access - 1:16 bit register access mode - not with the dma mode */
+        uint16_t reg_16_big_endian: 1; /**< 0:little endian for 16 bit mode - 1:big endian for 16 bit mode */
+        uint16_t padding: 7; /**< padding bits */
     };
-    uint8_t data; /**< Full bitfield data */
+    uint16_t data; /**< Full bitfield data */
 } spi_mode_t;
 MM_PACKED_END
 
@@ -184,7 +200,9 @@ typedef union {
         uint8_t init: 1; /**< 0:periph will initialize on execute - 1:periph initialized */
         uint8_t disable: 1; /**< 0:periph is enabled - 1:periph is disabled */
         uint8_t trig_edge: 2; /**< 0:both - 1:rising - 2:falling */
-        uint8_t padding: 4; /**< padding bits */
+        uint8_t cascade: 1; /**< 0:16 bit timer extended by overflow marks - 1:32 bit cascade of two timers captured in hardware - the lower half is latched 4 ticks after the edge so an edge within 4 ticks of a lower half wrap may be off by 65536 ticks - only for rising or falling edges */
+        uint8_t hist_pulse: 2; /**< Differences in the histogram and sums with both edges - 0:all - 1:high pulses - 2:low pulses */
+        uint8_t freq: 1; /**< 0:edges are captured - 1:edges are counted in hardware for the frequency and duty cycle - not with cascade */
     };
     uint8_t data; /**< Full bitfield data */
 } tmr_mode_t;
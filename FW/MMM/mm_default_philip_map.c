@@ -3,7 +3,7 @@
  * @addtogroup philip_map_mmm
  * @{
  * @file      mm_default_philip_map.c
- * @version   2.0.0
+ * @version   2.1.0
  * @}
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -16,11 +16,16 @@
 /* functions *****************************************************************/
 const void mm_defaults_init_philip_map(philip_map *init) {
     init->sys.device_num = MM_DEFAULT_PHILIP_MAP_SYS_DEVICE_NUM;
+    init->sys.if_baud = MM_DEFAULT_PHILIP_MAP_SYS_IF_BAUD;
     init->i2c.slave_addr_1 = MM_DEFAULT_PHILIP_MAP_I2C_SLAVE_ADDR_1;
     init->i2c.slave_addr_2 = MM_DEFAULT_PHILIP_MAP_I2C_SLAVE_ADDR_2;
+    init->spi.sm_bit_min = MM_DEFAULT_PHILIP_MAP_SPI_SM_BIT_MIN;
+    init->spi.sm_dead_min = MM_DEFAULT_PHILIP_MAP_SPI_SM_DEAD_MIN;
     init->adc.num_of_samples = MM_DEFAULT_PHILIP_MAP_ADC_NUM_OF_SAMPLES;
     init->pwm.h_ticks = MM_DEFAULT_PHILIP_MAP_PWM_H_TICKS;
     init->pwm.l_ticks = MM_DEFAULT_PHILIP_MAP_PWM_L_TICKS;
     init->dac.level = MM_DEFAULT_PHILIP_MAP_DAC_LEVEL;
     init->tmr.min_tick = MM_DEFAULT_PHILIP_MAP_TMR_MIN_TICK;
+    init->tmr.hist_numof = MM_DEFAULT_PHILIP_MAP_TMR_HIST_NUMOF;
+    init->tmr.gate_ms = MM_DEFAULT_PHILIP_MAP_TMR_GATE_MS;
 }
\ No newline at end of file
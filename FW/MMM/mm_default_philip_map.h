@@ -3,7 +3,7 @@
  * @addtogroup philip_map_mmm
  * @{
  * @file      mm_default_philip_map.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -20,13 +20,18 @@ extern "C"
 
 /* defines *******************************************************************/
 #define MM_DEFAULT_PHILIP_MAP_SYS_DEVICE_NUM 17061
+#define MM_DEFAULT_PHILIP_MAP_SYS_IF_BAUD 115200
 #define MM_DEFAULT_PHILIP_MAP_I2C_SLAVE_ADDR_1 85
 #define MM_DEFAULT_PHILIP_MAP_I2C_SLAVE_ADDR_2 66
+#define MM_DEFAULT_PHILIP_MAP_SPI_SM_BIT_MIN 65535
+#define MM_DEFAULT_PHILIP_MAP_SPI_SM_DEAD_MIN 65535
 #define MM_DEFAULT_PHILIP_MAP_ADC_NUM_OF_SAMPLES 1024
 #define MM_DEFAULT_PHILIP_MAP_PWM_H_TICKS 256
 #define MM_DEFAULT_PHILIP_MAP_PWM_L_TICKS 256
 #define MM_DEFAULT_PHILIP_MAP_DAC_LEVEL 5000
 #define MM_DEFAULT_PHILIP_MAP_TMR_MIN_TICK 4294967295
+#define MM_DEFAULT_PHILIP_MAP_TMR_HIST_NUMOF 32
+#define MM_DEFAULT_PHILIP_MAP_TMR_GATE_MS 100
 
 /* functions *****************************************************************/
 const void mm_defaults_init_philip_map(philip_map *init);
@@ -3,7 +3,7 @@
  * @addtogroup meta_mmm
  * @{
  * @file      mm_meta.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -20,16 +20,16 @@ extern "C"
 
 #define MM_APP_NAME "PHiLIP" /** Application name **/
 
-#define MM_VERSION_STR "2.0.0" /** Version string for the memory map interface **/
+#define MM_VERSION_STR "2.1.0" /** Version string for the memory map interface **/
 #define MM_MAJOR_VERSION 2 /** Major version of the memory map interface **/
-#define MM_MINOR_VERSION 0 /** Minor version of the memory map interface **/
+#define MM_MINOR_VERSION 1 /** Minor version of the memory map interface **/
 #define MM_PATCH_VERSION 0 /** Patch version of the memory map interface **/
 
 #define MM_USER_INTERFACE 1 /** interface user access **/
 #define MM_USER_PERIPHERAL 2 /** peripheral user access **/
 
-#define MM_FW_HASH  "c6764a596a2a03f1a328cd2135f44907" /** Hash for what effects the firmware */
-#define MM_HASH  "5ea942551b11de32981e5fe84c0ad1b2" /** Hash for the whole generated map */
+#define MM_FW_HASH  "0b8177e6dc7a07dc02a87a54ae208368" /** Hash for what effects the firmware */
+#define MM_HASH  "7b18f98efc7d8621218c28981ecb9908" /** Hash for the whole generated map */
 
 #ifdef __cplusplus
 }
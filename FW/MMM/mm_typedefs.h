@@ -3,7 +3,7 @@
  * @addtogroup typedef_mmm
  * @{
  * @file      mm_typedefs.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
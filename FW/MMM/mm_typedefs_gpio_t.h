@@ -3,7 +3,7 @@
  * @addtogroup typedefs_mmm
  * @{
  * @file      mm_typedefs_gpio_t.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -29,9 +29,10 @@ typedef union {
     struct {
         gpio_mode_t mode; /**< The selected GPIO mode */
         gpio_status_t status; /**< The status of the GPIO */
+        uint32_t capture_lost; /**< Edges the timer capture missed since the pin was committed - The buffer was full or the edges came faster than the interrupt could serve them */
         uint8_t padding[1]; /**< padding bytes */
     };
-    uint8_t data[4]; /**< Array for padding */
+    uint8_t data[8]; /**< Array for padding */
 } gpio_t;
 MM_PACKED_END
 
@@ -3,7 +3,7 @@
  * @addtogroup typedefs_mmm
  * @{
  * @file      mm_typedefs_map_t.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -24,8 +24,10 @@ extern "C"
 #include "mm_typedefs_dac_t.h"
 #include "mm_typedefs_gpio_t.h"
 #include "mm_typedefs_i2c_t.h"
+#include "mm_typedefs_prof_t.h"
 #include "mm_typedefs_pwm_t.h"
 #include "mm_typedefs_rtc_t.h"
+#include "mm_typedefs_sched_t.h"
 #include "mm_typedefs_spi_t.h"
 #include "mm_typedefs_sys_t.h"
 #include "mm_typedefs_tmr_t.h"
@@ -49,8 +51,10 @@ typedef union {
         tmr_t tmr; /**< TMR configuration */
         gpio_t gpio[3]; /**< GPIO pins available */
         trace_t trace; /**< Saved timestamps and events */
+        sched_t sched; /**< Task scheduler statistics */
+        prof_t prof; /**< Cycle count profiles of hot paths */
     };
-    uint8_t data[1813]; /**< Array for padding */
+    uint8_t data[3719]; /**< Array for padding */
 } map_t;
 MM_PACKED_END
 
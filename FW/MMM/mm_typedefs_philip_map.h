@@ -3,7 +3,7 @@
  * @addtogroup philip_map_mmm
  * @{
  * @file      mm_typedefs_philip_map.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -22,8 +22,10 @@ extern "C"
 #include "mm_typedefs_dac_t.h"
 #include "mm_typedefs_gpio_t.h"
 #include "mm_typedefs_i2c_t.h"
+#include "mm_typedefs_prof_t.h"
 #include "mm_typedefs_pwm_t.h"
 #include "mm_typedefs_rtc_t.h"
+#include "mm_typedefs_sched_t.h"
 #include "mm_typedefs_spi_t.h"
 #include "mm_typedefs_sys_t.h"
 #include "mm_typedefs_tmr_t.h"
@@ -0,0 +1,44 @@
+/**
+ ******************************************************************************
+ * @addtogroup typedefs_mmm
+ * @{
+ * @file      mm_typedefs_prof_entry_t.h
+ * @version   2.1.0
+ *
+ * @details   Generated from the memory map manager version 2.0.0
+ ******************************************************************************
+ */
+#ifndef MM_TYPEDEFS_PROF_ENTRY_T_H
+#define MM_TYPEDEFS_PROF_ENTRY_T_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* includes ******************************************************************/
+#include <stdint.h>
+
+#include "mm_cc.h"
+
+/* tyepdefs ******************************************************************/
+MM_PACKED_START
+/** @brief Cycle count profile of a function - Write 0 to the call count to reset */
+typedef union {
+    struct {
+        uint32_t call_count; /**< Amount of profiled calls */
+        uint32_t min_cycles; /**< Minimum cycles of a call */
+        uint32_t max_cycles; /**< Maximum cycles of a call */
+        uint32_t mean_cycles; /**< Mean cycles of a call */
+        uint64_t total_cycles; /**< Sum of the cycles of all calls */
+    };
+    uint8_t data[24]; /**< Array for padding */
+} prof_entry_t;
+MM_PACKED_END
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MM_TYPEDEFS_PROF_ENTRY_T_H */
+/** @} **/
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ ******************************************************************************
+ * @addtogroup typedefs_mmm
+ * @{
+ * @file      mm_typedefs_prof_t.h
+ * @version   2.1.0
+ *
+ * @details   Generated from the memory map manager version 2.0.0
+ ******************************************************************************
+ */
+#ifndef MM_TYPEDEFS_PROF_T_H
+#define MM_TYPEDEFS_PROF_T_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* includes ******************************************************************/
+#include <stdint.h>
+
+#include "mm_cc.h"
+#include "mm_typedefs_prof_entry_t.h"
+
+/* tyepdefs ******************************************************************/
+MM_PACKED_START
+/** @brief Cycle count profiles of hot paths - Only recorded in firmware built with PROFILE=1 */
+typedef union {
+    struct {
+        prof_entry_t entry[8]; /**< Profile of each function - 0:parse_command - 1:parse_frame - 2:_flush_tmr_buf - 3:poll_dut_spi_ic - 4:_i2c_it - 5:_spi_reg_int - 6:not used - 7:not used */
+    };
+    uint8_t data[192]; /**< Array for padding */
+} prof_t;
+MM_PACKED_END
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MM_TYPEDEFS_PROF_T_H */
+/** @} **/
\ No newline at end of file
@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @addtogroup typedefs_mmm
+ * @{
+ * @file      mm_typedefs_sched_t.h
+ * @version   2.1.0
+ *
+ * @details   Generated from the memory map manager version 2.0.0
+ ******************************************************************************
+ */
+#ifndef MM_TYPEDEFS_SCHED_T_H
+#define MM_TYPEDEFS_SCHED_T_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* includes ******************************************************************/
+#include <stdint.h>
+
+#include "mm_cc.h"
+#include "mm_typedefs_task_t.h"
+
+/* tyepdefs ******************************************************************/
+MM_PACKED_START
+/** @brief Task scheduler statistics */
+typedef union {
+    struct {
+        uint32_t max_loop_ticks; /**< Worst case time of a scheduler pass in system clock ticks - This is the latency of the polled tasks */
+        task_t task[18]; /**< Statistics of each task - 0:wdt - 1:led - 2:tick - 3:debug - 4:spi inputs - 5:i2c inputs - 6:uart inputs - 7:pwm inputs - 8:dac inputs - 9:tmr inputs - 10:rtc - 11:dut_ic drain - 12:spi clk drain - 13:adc - 14:dut uart - 15:if uart - 16:debug capture drain - 17:stack guard */
+    };
+    uint8_t data[220]; /**< Array for padding */
+} sched_t;
+MM_PACKED_END
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MM_TYPEDEFS_SCHED_T_H */
+/** @} **/
\ No newline at end of file
@@ -3,7 +3,7 @@
  * @addtogroup typedefs_mmm
  * @{
  * @file      mm_typedefs_spi_t.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -42,9 +42,26 @@ typedef union {
         uint32_t frame_ticks; /**< Ticks per frame */
         uint32_t byte_ticks; /**< Ticks per byte */
         uint32_t prev_ticks; /**< Holder for previous byte ticks */
-        uint32_t sm_buf[64]; /**< Buffer for captured timestamps for speed measurement */
+        uint32_t sm_buf[64]; /**< Buffer for the first captured timestamps of the speed measurement */
+        uint32_t sm_edges; /**< Clock edges captured since the speed measurement was committed */
+        uint32_t sm_lost; /**< Clock edges overwritten before they were measured */
+        uint32_t sm_frames; /**< Frames that ended during the speed measurement */
+        uint32_t sm_bit_count; /**< Amount of measured bit periods */
+        uint16_t sm_bit_min; /**< Shortest bit period in ticks */
+        uint16_t sm_bit_max; /**< Longest bit period in ticks */
+        uint64_t sm_bit_sum; /**< Sum of the bit periods in ticks - the mean is the sum divided by the count */
+        uint32_t sm_dead_count; /**< Amount of measured deadtimes between the bytes of a frame */
+        uint16_t sm_dead_min; /**< Shortest deadtime in ticks - the time between bytes exceeding the last bit period */
+        uint16_t sm_dead_max; /**< Longest deadtime in ticks */
+        uint64_t sm_dead_sum; /**< Sum of the deadtimes in ticks */
+        uint16_t sm_frame_bytes; /**< Completed bytes of the current or last frame */
+        uint32_t sm_frame_freq; /**< Mean clock frequency in Hz within the bytes of the current or last frame */
+        uint32_t sm_frame_rate; /**< Bit rate in Hz of the current or last frame including the deadtimes */
+        uint32_t sm_byte_freq[32]; /**< Mean clock frequency in Hz of each of the first bytes of the current or last frame */
+        uint32_t sniff_frames; /**< Frames that ended since the sniffer was committed */
+        uint32_t sniff_lost; /**< Frames dropped because the sniffer ring was not drained */
     };
-    uint8_t data[283]; /**< Array for padding */
+    uint8_t data[474]; /**< Array for padding */
 } spi_t;
 MM_PACKED_END
 
@@ -3,7 +3,7 @@
  * @addtogroup typedefs_mmm
  * @{
  * @file      mm_typedefs_sys_t.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -37,8 +37,9 @@ typedef union {
         uint32_t sys_clk;
         sys_status_t status; /**< Status of system */
         sys_mode_t mode; /**< Control register for device */
+        uint32_t if_baud; /**< Interface uart baudrate - Switches after execute and falls back if no command is received at the new baudrate within a second */
     };
-    uint8_t data[46]; /**< Array for padding */
+    uint8_t data[50]; /**< Array for padding */
 } sys_t;
 MM_PACKED_END
 
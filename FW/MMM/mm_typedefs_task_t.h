@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @addtogroup typedefs_mmm
+ * @{
+ * @file      mm_typedefs_task_t.h
+ * @version   2.1.0
+ *
+ * @details   Generated from the memory map manager version 2.0.0
+ ******************************************************************************
+ */
+#ifndef MM_TYPEDEFS_TASK_T_H
+#define MM_TYPEDEFS_TASK_T_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* includes ******************************************************************/
+#include <stdint.h>
+
+#include "mm_cc.h"
+
+/* tyepdefs ******************************************************************/
+MM_PACKED_START
+/** @brief Statistics of a scheduled task - Write 0 to reset */
+typedef union {
+    struct {
+        uint32_t run_count; /**< Amount of times the task ran */
+        uint32_t max_ticks; /**< Worst case runtime of the task in system clock ticks */
+        uint32_t overruns; /**< Amount of runs that took longer than the task budget or missed a whole period */
+    };
+    uint8_t data[12]; /**< Array for padding */
+} task_t;
+MM_PACKED_END
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MM_TYPEDEFS_TASK_T_H */
+/** @} **/
\ No newline at end of file
@@ -3,7 +3,7 @@
  * @addtogroup typedefs_mmm
  * @{
  * @file      mm_typedefs_tmr_t.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -32,8 +32,24 @@ typedef union {
         uint16_t min_holdoff; /**< The minimum amount of time to wait before triggering another event in ns */
         uint32_t min_tick; /**< Minimum tick difference */
         uint32_t max_tick; /**< Maximum tick difference */
+        uint32_t hist_start; /**< Tick difference at the lower bound of the first histogram bucket */
+        uint32_t hist_width; /**< Tick differences per histogram bucket - 0:histogram disabled */
+        uint8_t hist_numof; /**< Amount of histogram buckets used - at most 32 */
+        uint32_t hist_below; /**< Tick differences below the first histogram bucket */
+        uint32_t hist_above; /**< Tick differences above the last histogram bucket */
+        uint32_t hist[32]; /**< Tick differences in each histogram bucket */
+        uint32_t stat_count; /**< Amount of tick differences in the sums */
+        uint32_t stat_ref; /**< First tick difference - The sums are relative to it to keep the precision */
+        int64_t stat_sum; /**< Sum of the tick differences relative to stat_ref for the mean */
+        uint64_t stat_sum_sq; /**< Sum of the squared tick differences relative to stat_ref for the variance */
+        uint16_t gate_ms; /**< Time of a frequency counter gate in ms - The edges and the duty cycle are measured in alternate gates */
+        uint32_t gate_count; /**< Amount of finished frequency counter gates */
+        uint64_t gate_tick; /**< Length of the last edge gate in ticks */
+        uint32_t edge_count; /**< Edges counted in the last edge gate */
+        uint32_t freq; /**< Frequency of the last edge gate in Hz - With both edges it is half the edges */
+        uint16_t duty; /**< High time of the last duty gate in 0.01 percent */
     };
-    uint8_t data[12]; /**< Array for padding */
+    uint8_t data[205]; /**< Array for padding */
 } tmr_t;
 MM_PACKED_END
 
@@ -3,7 +3,7 @@
  * @addtogroup typedefs_mmm
  * @{
  * @file      mm_typedefs_trace_t.h
- * @version   2.0.0
+ * @version   2.1.0
  *
  * @details   Generated from the memory map manager version 2.0.0
  ******************************************************************************
@@ -20,6 +20,7 @@ extern "C"
 #include <stdint.h>
 
 #include "mm_cc.h"
+#include "mm_bitfields.h"
 
 /* tyepdefs ******************************************************************/
 MM_PACKED_START
@@ -30,9 +31,30 @@ typedef union {
         uint8_t tick_div[128]; /**< The tick divisor of the event - max should be 16 for interface */
         uint8_t source[128]; /**< The event source of the event - 0:no source selected - 1:DEBUG0 pin - 2:DEBUG1 pin - 3:DEBUG2 pin - 4:DUT_IC */
         uint16_t value[128]; /**< The value of the event - 0:falling edge interrupt - 1:rising edge interrupt */
-        uint32_t tick[128]; /**< The tick when the event occurred */
+        uint32_t tick[128]; /**< The lower 32 bits of the tick when the event occurred */
+        uint32_t tick_hi[128]; /**< The upper 32 bits of the tick - With tick it is a 64 bit tick that does not wrap */
+        trace_mode_t mode; /**< Trace mode settings */
+        uint16_t stream_size; /**< Amount of events the stream ring can hold */
+        uint16_t stream_level; /**< Amount of events waiting in the stream ring */
+        uint16_t stream_high_water; /**< Most events that waited in the stream ring since the trace initialized */
+        uint16_t stack_guard_used; /**< Bytes of the 256 byte guard gap between the stream ring and the stack that the stack used - Nonzero means the stack outgrew its size - Once the whole gap is used the stream mode is turned off */
+        uint32_t stream_overruns; /**< Amount of events lost because the stream ring was full */
+        uint32_t next_seq; /**< Sequence number of the next event - Lost events use a sequence number too so gaps show where events are missing */
+        uint32_t count; /**< Events stored in the trace registers - With the index it is the cursor of incremental reads - The entries after the previous count are new */
+        uint32_t seq[128]; /**< The sequence number of the event */
+        uint32_t dropped[4]; /**< Events lost by source - 0:DEBUG0 - 1:DEBUG1 - 2:DEBUG2 - 3:DUT_IC - Lost events are overwritten in the trace registers or did not fit in the stream ring */
+        uint8_t pre_depth; /**< Events before the trigger kept in the capture window - at most 64 */
+        uint16_t post_depth; /**< Events from the trigger on in the capture window - 0:no end */
+        uint8_t trig_source; /**< Event source of the event trigger - 1:DEBUG0 - 2:DEBUG1 - 3:DEBUG2 - 4:DUT_IC */
+        uint16_t trig_value; /**< Event value of the event trigger - 0:falling edge - 1:rising edge */
+        uint16_t trig_addr; /**< Register written by the DUT for the write trigger */
+        uint32_t trig_count; /**< DUT_IC events until the count trigger */
+        uint64_t trig_tick; /**< Tick of the deadline trigger in the ticks of tick_div 0 */
+        uint8_t trig_state; /**< State of the capture window - 0:no trigger - 1:armed - 2:triggered - 3:window full */
+        uint32_t trig_seq; /**< Sequence number of the first event from the trigger on */
+        uint64_t trig_time; /**< Tick of the trigger in the ticks of tick_div 0 */
     };
-    uint8_t data[1028]; /**< Array for padding */
+    uint8_t data[2122]; /**< Array for padding */
 } trace_t;
 MM_PACKED_END
 
@@ -0,0 +1,36 @@
+/**
+ ******************************************************************************
+ * @addtogroup philip_map_mmm
+ * @{
+ * @file      mm_write_map_philip_map.h
+ *
+ * @details   Generated by generate_write_map.py from mm_access_philip_map.c
+ ******************************************************************************
+ */
+#ifndef MM_WRITE_MAP_PHILIP_MAP_H
+#define MM_WRITE_MAP_PHILIP_MAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* includes ******************************************************************/
+#include <stdint.h>
+
+/* defs **********************************************************************/
+#define MM_WRITE_MAP_PHILIP_MAP_SIZE 3719 /** Register bytes covered **/
+#define MM_WRITE_MAP_PHILIP_MAP_LEVELS 2 /** Bitmaps, one per access level **/
+#define MM_WRITE_MAP_PHILIP_MAP_WORDS 117 /** Words of a bitmap **/
+
+/* variables *****************************************************************/
+/** @brief  Write permission of each register byte, index 0 is the interface
+ *          and index 1 the peripheral */
+extern const uint32_t mm_write_map_philip_map[MM_WRITE_MAP_PHILIP_MAP_LEVELS][MM_WRITE_MAP_PHILIP_MAP_WORDS];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MM_WRITE_MAP_PHILIP_MAP_H */
+/** @} **/
\ No newline at end of file
@@ -0,0 +1,274 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup Application
+ * @{
+ * @file			app_bin_if.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Binary framed protocol for application communication.
+ * @details			Moves raw register bytes with a length, sequence number
+ * 					and CRC instead of the ASCII/JSON encoding of the shell.
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <errno.h>
+#include <stdint.h>
+
+#include "stm32f1xx_hal.h"
+
+#include "mm_typedefs.h"
+#include "mm_access_types.h"
+#include "app_common.h"
+#include "app_reg.h"
+#include "trace.h"
+#include "spi.h"
+
+#include "app_bin_if.h"
+
+/* Private defines ************************************************************/
+/** @brief   Offset of the sequence number in the frame */
+#define SEQ_OFFSET		(1)
+
+/** @brief   Offset of the payload length in the frame */
+#define LEN_OFFSET		(2)
+
+/** @brief   Offset of the payload in the frame */
+#define PAYLOAD_OFFSET	(BIN_HDR_SIZE)
+
+/* Private macros *************************************************************/
+/** @brief   Reads a little endian uint16 from a byte buffer */
+#define GET_U16(x)		((uint16_t)((x)[0] | ((x)[1] << 8)))
+
+/** @brief   Reads a little endian uint32 from a byte buffer */
+#define GET_U32(x)		((uint32_t)GET_U16(x) | ((uint32_t)GET_U16(&(x)[2]) << 16))
+
+/** @brief   Writes a little endian uint16 to a byte buffer */
+#define SET_U16(x, val)	do { (x)[0] = (uint8_t)(val); \
+							(x)[1] = (uint8_t)((val) >> 8); } while (0)
+
+/* Private function prototypes ************************************************/
+static error_t _frame_read_reg(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size);
+static error_t _frame_write_reg(uint8_t *payload, uint16_t len,
+		uint8_t access);
+static error_t _frame_execute(uint8_t access);
+static error_t _frame_dump_trace(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size);
+static error_t _frame_read_regs(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size);
+static error_t _frame_drain_trace(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size);
+static error_t _frame_drain_spi_sniff(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size);
+static uint16_t _finish_frame(uint8_t *frame, uint16_t len);
+
+/******************************************************************************/
+/*           Functions                                                        */
+/******************************************************************************/
+uint8_t is_bin_frame(const uint8_t *frame) {
+	return frame[0] == BIN_SOF;
+}
+
+uint32_t bin_frame_size(const uint8_t *frame, uint16_t rx_amount) {
+	if (rx_amount < BIN_HDR_SIZE) {
+		return 0;
+	}
+	return GET_U16(&frame[LEN_OFFSET]) + BIN_FRAME_OVERHEAD;
+}
+
+error_t parse_frame(uint8_t *frame, uint16_t buf_size, uint16_t *size,
+		uint8_t access) {
+	uint8_t *payload = &frame[PAYLOAD_OFFSET];
+	uint16_t len = GET_U16(&frame[LEN_OFFSET]);
+	/* Responses are shorter than the buffer so the overflow byte stays 0 */
+	uint16_t max_data = buf_size - 1 - BIN_FRAME_OVERHEAD - BIN_RESP_HDR_SIZE;
+	uint16_t data_size = 0;
+	uint8_t cmd = 0;
+	error_t err;
+
+	if (len + BIN_FRAME_OVERHEAD > buf_size - 1) {
+		err = EMSGSIZE;
+	} else if (len == 0) {
+		err = ENODATA;
+	} else if (bin_crc16(&frame[SEQ_OFFSET], len + BIN_HDR_SIZE - SEQ_OFFSET)
+			!= GET_U16(&payload[len])) {
+		err = EBADMSG;
+	} else {
+		cmd = payload[0];
+		if (cmd == BIN_CMD_READ_REG) {
+			err = _frame_read_reg(payload, len, max_data, &data_size);
+		} else if (cmd == BIN_CMD_WRITE_REG) {
+			err = _frame_write_reg(payload, len, access);
+		} else if (cmd == BIN_CMD_EXECUTE) {
+			err = _frame_execute(access);
+		} else if (cmd == BIN_CMD_DUMP_TRACE) {
+			err = _frame_dump_trace(payload, len, max_data, &data_size);
+		} else if (cmd == BIN_CMD_READ_REGS) {
+			err = _frame_read_regs(payload, len, max_data, &data_size);
+		} else if (cmd == BIN_CMD_DRAIN_TRACE) {
+			err = _frame_drain_trace(payload, len, max_data, &data_size);
+		} else if (cmd == BIN_CMD_DRAIN_SPI_SNIFF) {
+			err = _frame_drain_spi_sniff(payload, len, max_data, &data_size);
+		} else {
+			err = EPROTONOSUPPORT;
+		}
+	}
+	if (err != 0) {
+		data_size = 0;
+	}
+	payload[0] = cmd;
+	payload[1] = (uint8_t)err;
+	*size = _finish_frame(frame, data_size + BIN_RESP_HDR_SIZE);
+	return err;
+}
+
+/******************************************************************************/
+static error_t _frame_read_reg(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size) {
+	uint16_t index;
+	uint16_t size;
+	error_t err;
+
+	if (len < 5) {
+		return ENODATA;
+	}
+	index = GET_U16(&payload[1]);
+	size = GET_U16(&payload[3]);
+	if (size > max_data) {
+		return ERANGE;
+	}
+	err = read_regs(index, &payload[BIN_RESP_HDR_SIZE], size);
+	if (err == 0) {
+		*data_size = size;
+	}
+	return err;
+}
+
+static error_t _frame_write_reg(uint8_t *payload, uint16_t len,
+		uint8_t access) {
+	if (len < 4) {
+		return ENODATA;
+	}
+	return write_regs(GET_U16(&payload[1]), &payload[3], len - 3, access);
+}
+
+static error_t _frame_execute(uint8_t access) {
+	if (!(access & MM_ACCESS_INTERFACE)) {
+		return EACCES;
+	}
+	return execute_reg_change();
+}
+
+static error_t _frame_dump_trace(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size) {
+	uint8_t *data = &payload[BIN_RESP_HDR_SIZE];
+	uint16_t start = 0;
+	uint32_t since;
+	uint16_t total;
+
+	if (len >= 3) {
+		start = GET_U16(&payload[1]);
+	}
+	if (len >= 7) {
+		since = GET_U32(&payload[3]);
+	}
+	*data_size = dump_trace(start, len >= 7 ? &since : NULL, &data[2],
+			max_data - 2, &total) + 2;
+	SET_U16(data, total);
+	return 0;
+}
+
+static error_t _frame_read_regs(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size) {
+	uint16_t spans[READ_REGS_MAX_SPANS * 2];
+	uint16_t count = (len - 1) / 2;
+
+	if (count == 0 || (count & 1)) {
+		return ENODATA;
+	}
+	if (count > READ_REGS_MAX_SPANS * 2) {
+		return EMSGSIZE;
+	}
+	/* The data overwrites the spans in the payload */
+	for (int i = 0; i < count; i++) {
+		spans[i] = GET_U16(&payload[1 + i * 2]);
+	}
+	return read_regs_list(spans, count / 2, &payload[BIN_RESP_HDR_SIZE],
+			max_data, data_size);
+}
+
+static error_t _frame_drain_trace(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size) {
+	uint8_t *data = &payload[BIN_RESP_HDR_SIZE];
+	uint16_t pos;
+	uint16_t pending;
+	error_t err;
+
+	if (len < 3) {
+		return ENODATA;
+	}
+	err = drain_trace(GET_U16(&payload[1]), &data[4], max_data - 4,
+			data_size, &pos, &pending);
+	if (err == 0) {
+		SET_U16(data, pos);
+		SET_U16(&data[2], pending);
+		*data_size += 4;
+	}
+	return err;
+}
+
+static error_t _frame_drain_spi_sniff(uint8_t *payload, uint16_t len,
+		uint16_t max_data, uint16_t *data_size) {
+	uint8_t *data = &payload[BIN_RESP_HDR_SIZE];
+	uint16_t pos;
+	uint16_t pending;
+	error_t err;
+
+	if (len < 3) {
+		return ENODATA;
+	}
+	err = drain_dut_spi_sniff(GET_U16(&payload[1]), &data[4], max_data - 4,
+			data_size, &pos, &pending);
+	if (err == 0) {
+		SET_U16(data, pos);
+		SET_U16(&data[2], pending);
+		*data_size += 4;
+	}
+	return err;
+}
+
+static uint16_t _finish_frame(uint8_t *frame, uint16_t len) {
+	uint16_t crc;
+
+	frame[0] = BIN_SOF;
+	SET_U16(&frame[LEN_OFFSET], len);
+	crc = bin_crc16(&frame[SEQ_OFFSET], len + BIN_HDR_SIZE - SEQ_OFFSET);
+	SET_U16(&frame[PAYLOAD_OFFSET + len], crc);
+	return len + BIN_FRAME_OVERHEAD;
+}
+
+/******************************************************************************/
+uint16_t bin_crc16(const uint8_t *data, uint32_t size) {
+	uint16_t crc = 0xFFFF;
+
+	while (size--) {
+		crc ^= (uint16_t)(*data++) << 8;
+		for (uint8_t i = 0; i < 8; i++) {
+			if (crc & 0x8000) {
+				crc = (crc << 1) ^ 0x1021;
+			} else {
+				crc <<= 1;
+			}
+		}
+	}
+	return crc;
+}
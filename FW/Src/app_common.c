@@ -21,7 +21,6 @@
  */
 
 /* Includes *******************************************************************/
-#include <string.h>
 #include <stdint.h>
 
 #include "stm32f1xx_hal.h"
@@ -79,6 +78,10 @@ uint32_t get_tick32() {
 
 
 uint32_t get_tick32_div(uint8_t div) {
+	return (uint32_t)get_tick64_div(div);
+}
+
+uint64_t get_tick64_div(uint8_t div) {
 	uint32_t sys_tick;
 	uint32_t tick;
 	int runs = 0;
@@ -94,20 +97,9 @@ uint32_t get_tick32_div(uint8_t div) {
 		 */
 		tick++;
 	}
-	return (uint32_t) (((uint32_t) (tick << (TICK_BIT_OFFSET - div))
-			+ ((SysTick->LOAD - sys_tick) >> div)));
+	return ((uint64_t)tick << (TICK_BIT_OFFSET - div))
+			+ ((SysTick->LOAD - sys_tick) >> div);
 }
-/******************************************************************************/
-#pragma GCC push_options
-#pragma GCC optimize ("O0")
-void copy_until_same(void *dest, void *src, size_t size) {
-
-	while (memcmp(dest, src, size)) {
-		memcpy(dest, src, size);
-	}
-}
-#pragma GCC pop_options
-
 /******************************************************************************/
 inline void soft_reset() {
 	NVIC_SystemReset();
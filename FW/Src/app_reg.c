@@ -22,12 +22,15 @@
 
 /* Includes *******************************************************************/
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "stm32f1xx_hal.h"
 
 #include "mm_typedefs.h"
 #include "mm_access.h"
+#include "mm_write_map_philip_map.h"
 #include "app_common.h"
 #include "app_reg.h"
 
@@ -40,10 +43,56 @@
 #include "adc.h"
 #include "tmr.h"
 #include "sys.h"
+#include "trace.h"
+
+/* Private defines ************************************************************/
+/** @brief	Copies tried before falling back to disabling interrupts */
+#define SNAP_TRIES	(2)
+
+/** @brief	The write bitmaps are generated separately from the map */
+_Static_assert(MM_WRITE_MAP_PHILIP_MAP_SIZE == sizeof(map_t),
+		"run scripts/generate_write_map.py after changing the map");
+
+/* Global variables ***********************************************************/
+volatile uint32_t reg_snap_seq[REG_SNAP_NUMOF] = {0};
 
 /* Private variables **********************************************************/
 static map_t *app_reg;
 
+/** @brief	Offset and size of each register group */
+static const uint16_t snap_range[REG_SNAP_NUMOF][2] = {
+	[REG_SNAP_USER] = {offsetof(map_t, user_reg), sizeof(app_reg->user_reg)},
+	[REG_SNAP_I2C] = {offsetof(map_t, i2c), sizeof(i2c_t)},
+	[REG_SNAP_SPI] = {offsetof(map_t, spi), sizeof(spi_t)},
+	[REG_SNAP_UART] = {offsetof(map_t, uart), sizeof(uart_t)},
+	[REG_SNAP_TRACE] = {offsetof(map_t, trace), sizeof(trace_t)},
+	[REG_SNAP_PROF] = {offsetof(map_t, prof), sizeof(prof_t)},
+	[REG_SNAP_TMR] = {offsetof(map_t, tmr), sizeof(tmr_t)},
+};
+
+/** @brief	Commits of the periphs in the order they are executed */
+static error_t (* const commits[])() = {
+	commit_debug,
+	commit_dut_i2c,
+	commit_dut_spi,
+	commit_dut_pwm,
+	commit_dut_dac,
+	commit_dut_uart,
+	commit_rtc,
+	commit_dut_adc,
+	commit_sys,
+	commit_dut_ic,
+	commit_trace,
+};
+
+/* Private function prototypes ************************************************/
+static uint8_t _snap_mask(const uint16_t *spans, uint16_t count);
+static uint32_t _snap_seq(uint8_t mask);
+static void _copy_spans(const uint16_t *spans, uint16_t count, uint8_t *data);
+static void _snapshot(const uint16_t *spans, uint16_t count, uint8_t *data);
+static uint8_t _can_write(uint32_t index, uint16_t size, uint8_t access);
+static uint8_t _is_busy(error_t err);
+
 /******************************************************************************/
 /*           Initialization                                                   */
 /******************************************************************************/
@@ -59,18 +108,25 @@ void init_app_reg(map_t *reg) {
 /*           Functions                                                        */
 /******************************************************************************/
 error_t execute_reg_change() {
-	commit_debug();
-	commit_dut_i2c();
-	commit_dut_spi();
-	commit_dut_pwm();
-	commit_dut_dac();
-	commit_dut_uart();
-	commit_rtc();
-	commit_dut_adc();
-	commit_sys();
-	commit_dut_ic();
+	uint8_t busy[sizeof(commits) / sizeof(commits[0])];
+	error_t err = 0;
 
-	return 0;
+	for (uint8_t i = 0; i < sizeof(commits) / sizeof(commits[0]); i++) {
+		busy[i] = _is_busy(commits[i]());
+	}
+	/* Periphs that share a dma channel or timer are busy until the holder
+	 * releases it, the holder may be committed later in the list */
+	for (uint8_t i = 0; i < sizeof(commits) / sizeof(commits[0]); i++) {
+		if (busy[i] && _is_busy(commits[i]())) {
+			err = EBUSY;
+		}
+	}
+	return err;
+}
+
+/* Some periphs return a negative errno */
+static uint8_t _is_busy(error_t err) {
+	return err == EBUSY || err == -EBUSY;
 }
 
 /******************************************************************************/
@@ -87,14 +143,92 @@ error_t read_reg(uint32_t index, uint8_t *data) {
 }
 
 error_t read_regs(uint32_t index, uint8_t *data, uint16_t size) {
+	uint16_t span[2];
+
 	if (index + size > get_reg_size()) {
 		return EOVERFLOW;
 	}
-	copy_until_same(data, &app_reg->data[index], size);
+	span[0] = index;
+	span[1] = size;
+	_snapshot(span, 1, data);
 
 	return 0;
 }
 
+error_t read_regs_list(const uint16_t *spans, uint16_t count, uint8_t *data,
+		uint16_t max_size, uint16_t *size) {
+	uint32_t total = 0;
+
+	for (int i = 0; i < count; i++) {
+		if (spans[i * 2] + spans[i * 2 + 1] > get_reg_size()) {
+			return EOVERFLOW;
+		}
+		total += spans[i * 2 + 1];
+	}
+	if (total > max_size) {
+		return ERANGE;
+	}
+	_snapshot(spans, count, data);
+	*size = total;
+	return 0;
+}
+
+/******************************************************************************/
+static uint8_t _snap_mask(const uint16_t *spans, uint16_t count) {
+	uint8_t mask = 0;
+
+	for (int group = 0; group < REG_SNAP_NUMOF; group++) {
+		uint16_t start = snap_range[group][0];
+		uint16_t end = start + snap_range[group][1];
+
+		for (int i = 0; i < count; i++) {
+			if (spans[i * 2] < end && spans[i * 2] + spans[i * 2 + 1] > start) {
+				mask |= 1 << group;
+				break;
+			}
+		}
+	}
+	return mask;
+}
+
+static uint32_t _snap_seq(uint8_t mask) {
+	uint32_t seq = 0;
+
+	for (int group = 0; group < REG_SNAP_NUMOF; group++) {
+		if (mask & (1 << group)) {
+			seq += reg_snap_seq[group];
+		}
+	}
+	/* Keeps the compiler from moving the copy across the counter reads */
+	__DMB();
+	return seq;
+}
+
+static void _copy_spans(const uint16_t *spans, uint16_t count, uint8_t *data) {
+	for (int i = 0; i < count; i++) {
+		memcpy(data, &app_reg->data[spans[i * 2]], spans[i * 2 + 1]);
+		data += spans[i * 2 + 1];
+	}
+}
+
+static void _snapshot(const uint16_t *spans, uint16_t count, uint8_t *data) {
+	uint8_t mask = _snap_mask(spans, count);
+	uint32_t seq;
+
+	/* Interrupts only bump the counters after writing so an unchanged sum
+	 * means no interrupt wrote to the copied groups during the copy */
+	for (int i = 0; i < SNAP_TRIES; i++) {
+		seq = _snap_seq(mask);
+		_copy_spans(spans, count, data);
+		if (seq == _snap_seq(mask)) {
+			return;
+		}
+	}
+	DIS_INT;
+	_copy_spans(spans, count, data);
+	EN_INT;
+}
+
 /******************************************************************************/
 error_t write_reg(uint32_t index, uint8_t data, uint8_t access) {
 
@@ -105,19 +239,59 @@ error_t write_regs(uint32_t index, uint8_t *data, uint16_t size, uint8_t access)
 	if (index + size > get_reg_size()) {
 		return EOVERFLOW;
 	}
-	for (int i = 0; i < size; i++) {
-		if (!(mm_access_philip_map(index + i).write_permission & access)) {
-			return EACCES;
-		}
+	if (!_can_write(index, size, access)) {
+		return EACCES;
 	}
 	for (int i = 0; i < size; i++) {
 		DIS_INT;
 		app_reg->data[index + i] = data[i];
 		EN_INT;
 	}
+	/* The DUT writes from the i2c and spi interrupts */
+	if (access == MM_ACCESS_PERIPHERAL) {
+		uint16_t span[2] = {index, size};
+		uint8_t mask = _snap_mask(span, 1);
+
+		for (int group = 0; group < REG_SNAP_NUMOF; group++) {
+			if (mask & (1 << group)) {
+				REG_SNAP_CHANGED(group);
+			}
+		}
+		trigger_trace_write(index, size);
+	}
 	return 0;
 }
 
+/* Checks a run of bytes against the generated write bitmap of the access
+ * level a word at a time */
+static uint8_t _can_write(uint32_t index, uint16_t size, uint8_t access) {
+	const uint32_t *map;
+	uint32_t end = index + size;
+
+	if (access & MM_ACCESS_INTERFACE) {
+		map = mm_write_map_philip_map[0];
+	} else if (access & MM_ACCESS_PERIPHERAL) {
+		map = mm_write_map_philip_map[1];
+	} else {
+		return 0;
+	}
+	while (index < end) {
+		uint32_t bit = index % 32;
+		uint32_t bits = 32 - bit;
+		uint32_t mask;
+
+		if (bits > end - index) {
+			bits = end - index;
+		}
+		mask = (bits == 32) ? 0xFFFFFFFF : ((1UL << bits) - 1) << bit;
+		if ((map[index / 32] & mask) != mask) {
+			return 0;
+		}
+		index += bits;
+	}
+	return 1;
+}
+
 /******************************************************************************/
 void add_index(uint16_t *i) {
 	(*i)++;
@@ -34,6 +34,7 @@
 #include "app_common.h"
 #include "app_reg.h"
 #include "map_if.h"
+#include "uart.h"
 
 #include "app_shell_if.h"
 
@@ -41,6 +42,9 @@
 /** @brief   The command to read application registers */
 #define READ_REG_CMD	"rr "
 
+/** @brief   The command to read several ranges of application registers */
+#define READ_REGS_CMD	"rrs "
+
 /** @brief   The command to write application registers */
 #define WRITE_REG_CMD	"wr "
 
@@ -65,6 +69,9 @@
 /** @brief   Prints a help menu */
 #define HELP_CMD		"help\n"
 
+/** @brief   Changes the baudrate of the interface after the response */
+#define BAUD_CMD		"baud "
+
 /** @brief   Gives properties of the memory map for a given index */
 #define MEMORY_MAP_CMD	"mm "
 
@@ -76,6 +83,9 @@
 
 /** @brief   Writes a value to a record name */
 #define WRITE_KEY_CMD	"w "
+
+/** @brief   Prefix of an optional request id that is echoed in the response */
+#define REQ_ID_CHAR		'@'
 /** @} */
 
 /** @brief   Maximum characters for parsing strings to numbers */
@@ -84,6 +94,9 @@
 /** @brief   Error code for parsing strings to numbers */
 #define ATOU_ERROR		0xFFFFFFFF
 
+/** @brief   Max characters of the request id in the response */
+#define REQ_ID_MAX_CHAR	(sizeof("\"id\":4294967295,") - 1)
+
 /** @brief   Macro for max values of a byte */
 #define BYTE_MAX		((uint8_t)0xFF)
 
@@ -96,15 +109,20 @@
 
 /* Private function prototypes ************************************************/
 static error_t _cmd_read_reg(char *str, uint16_t buf_size);
+static error_t _cmd_read_regs(char *str, uint16_t buf_size);
 static error_t _cmd_write_reg(char *str, uint16_t buf_size, uint8_t access);
 static error_t _cmd_execute(char *str);
 static error_t _cmd_reset();
+static error_t _cmd_baud(char *str);
 static error_t _cmd_print_help(char *str);
 static error_t _cmd_print_version(char *str);
 
 static error_t _valid_args(char *str, uint32_t *arg_count, uint16_t buf_size);
 static uint32_t _fast_atou(char **str, char terminator);
 
+static uint32_t _strip_req_id(char *str);
+static error_t _add_req_id(char *str, uint16_t buf_size, uint32_t req_id);
+
 static void _json_result(char *str, error_t result);
 
 /******************************************************************************/
@@ -112,13 +130,22 @@ static void _json_result(char *str, error_t result);
 /******************************************************************************/
 error_t parse_command(char *str, uint16_t buf_size, uint8_t access) {
 	error_t err = EPROTONOSUPPORT;
+	uint32_t req_id = ATOU_ERROR;
 
 	if (str[buf_size - 1] != 0) {
 		_json_result(str, EMSGSIZE);
+	} else if (str[0] == REQ_ID_CHAR) {
+		req_id = _strip_req_id(str);
+		if (req_id == ATOU_ERROR) {
+			err = EINVAL;
+			str[0] = 0;
+		}
 	}
 
 	if (IS_COMMAND(READ_REG_CMD)) {
 		err = _cmd_read_reg(str, buf_size);
+	} else if (IS_COMMAND(READ_REGS_CMD)) {
+		err = _cmd_read_regs(str, buf_size);
 	} else if (IS_COMMAND(WRITE_REG_CMD)) {
 		err = _cmd_write_reg(str, buf_size, access);
 	} else if (IS_COMMAND(HELP_CMD)) {
@@ -138,6 +165,12 @@ error_t parse_command(char *str, uint16_t buf_size, uint8_t access) {
 		} else {
 			err = _cmd_reset();
 		}
+	} else if (IS_COMMAND(BAUD_CMD)) {
+		if (!(access & MM_ACCESS_INTERFACE)) {
+			err = EACCES;
+		} else {
+			err = _cmd_baud(str);
+		}
 	}
 	if (str[buf_size - 1] != 0) {
 		err = EMSGSIZE;
@@ -146,6 +179,11 @@ error_t parse_command(char *str, uint16_t buf_size, uint8_t access) {
 	if (err != 0) {
 		_json_result(str, err);
 	}
+	if (req_id != ATOU_ERROR && _add_req_id(str, buf_size, req_id) != 0) {
+		err = ERANGE;
+		_json_result(str, err);
+		_add_req_id(str, buf_size, req_id);
+	}
 
 	return err;
 }
@@ -190,6 +228,54 @@ static error_t _cmd_read_reg(char *str, uint16_t buf_size) {
 	return 0;
 }
 
+static error_t _cmd_read_regs(char *str, uint16_t buf_size) {
+	char *arg_str = str + strlen(READ_REGS_CMD);
+	char *end_check_str;
+	uint16_t spans[READ_REGS_MAX_SPANS * 2];
+	uint16_t count = 0;
+	uint16_t max_size;
+	uint16_t size;
+	uint8_t *data;
+	uint32_t val;
+	error_t err;
+
+	do {
+		end_check_str = arg_str;
+		val = _fast_atou(&end_check_str, ' ');
+		if (val == ATOU_ERROR) {
+			val = _fast_atou(&arg_str, RX_END_CHAR);
+			end_check_str = NULL;
+		} else {
+			arg_str = end_check_str;
+		}
+		if (val == ATOU_ERROR || val > UINT16_MAX) {
+			return EINVAL;
+		}
+		if (count == READ_REGS_MAX_SPANS * 2) {
+			return EMSGSIZE;
+		}
+		spans[count++] = val;
+	} while (end_check_str != NULL);
+	if (count & 1) {
+		return ENODATA;
+	}
+
+	/* The data is read to the end of the buffer, each byte is printed with
+	 * at most 4 chars so the output never reaches the unprinted data */
+	max_size = (buf_size - strlen("{\"data\":[], \"result\":0}\n") - 1) / 4;
+	data = (uint8_t*)&str[buf_size - 1 - max_size];
+	err = read_regs_list(spans, count / 2, data, max_size, &size);
+	if (err != 0) {
+		return err;
+	}
+	str += sprintf(str, "{\"data\":[");
+	for (int i = 0; i < size; i++) {
+		str += sprintf(str, i ? ",%u" : "%u", data[i]);
+	}
+	sprintf(str, "], \"result\":0}\n");
+	return 0;
+}
+
 static error_t _cmd_write_reg(char *str, uint16_t buf_size, uint8_t access) {
 	uint32_t arg_count = 0;
 	error_t err;
@@ -241,6 +327,21 @@ static error_t _cmd_execute(char *str) {
 	return err;
 }
 
+static error_t _cmd_baud(char *str) {
+	char *arg_str = str + strlen(BAUD_CMD);
+	uint32_t baud = _fast_atou(&arg_str, RX_END_CHAR);
+	error_t err;
+
+	if (baud == ATOU_ERROR) {
+		return EINVAL;
+	}
+	err = set_if_uart_baud(baud);
+	if (err == 0) {
+		_json_result(str, 0);
+	}
+	return err;
+}
+
 static error_t _cmd_print_version(char *str) {
 	sprintf(str, "{\"version\":\"%u.%u.%u\",\"result\":0}\n", MM_MAJOR_VERSION,
 			MM_MINOR_VERSION, MM_PATCH_VERSION);
@@ -250,9 +351,11 @@ static error_t _cmd_print_version(char *str) {
 static error_t _cmd_print_help(char *str) {
 	sprintf(str,
 			"rr <reg_offset> <size> : Reads bytes\n\
+rrs <reg_offset> <size> [<reg_offset> <size>] ... : Reads several ranges\n\
 wr <reg_offest> <DATA0> [DATA1] ... [DATAn] : Writes bytes\n\
 ex : Executes config changes\n\
 mcu_rst : Soft reset\n\
+baud <rate> : Changes the interface baudrate\n\
 version : Interface version\n");
 	return 0;
 }
@@ -333,6 +436,34 @@ uint32_t _fast_atou(char **str, char terminator) {
 	return val;
 }
 
+static uint32_t _strip_req_id(char *str) {
+	char *cmd_str = str + 1;
+	uint32_t req_id = _fast_atou(&cmd_str, ' ');
+
+	if (req_id != ATOU_ERROR) {
+		memmove(str, cmd_str, strlen(cmd_str) + 1);
+	}
+	return req_id;
+}
+
+static error_t _add_req_id(char *str, uint16_t buf_size, uint32_t req_id) {
+	char id_str[REQ_ID_MAX_CHAR + 1];
+	uint16_t id_size;
+	uint16_t size = strlen(str);
+
+	/* Only json responses can hold the id */
+	if (str[0] != '{') {
+		return 0;
+	}
+	id_size = sprintf(id_str, "\"id\":%lu,", (unsigned long)req_id);
+	if (size + id_size >= buf_size) {
+		return ERANGE;
+	}
+	memmove(&str[1 + id_size], &str[1], size);
+	memcpy(&str[1], id_str, id_size);
+	return 0;
+}
+
 static void _json_result(char *str, error_t result) {
 	sprintf(str, "{\"result\":%d}\n", result);
 }
@@ -18,6 +18,12 @@
  * 					initialization.
  * 					The interrupt mode of the GPIO can log ticks at a rate of
  * 					100kHz, any faster and logs will be missed.
+ * 					With capture set a timer latches the tick of each edge so
+ * 					the interrupt latency does not add jitter, the edges are
+ * 					merged into the trace when polling.
+ * 					A pin with capture dma channels needs no interrupt per
+ * 					edge, its captures are drained every half ring and every
+ * 					timer period.
  *
  ******************************************************************************
  */
@@ -36,6 +42,21 @@
 
 #include "gpio.h"
 
+/* Private defines ************************************************************/
+/** @brief	Captured edges each DEBUG pin buffers until polled, power of 2 */
+#define DEBUG_IC_BUF_SIZE	(64)
+
+/** @brief	Ticks of a capture timer period */
+#define DEBUG_IC_PERIOD		(0x10000)
+
+#ifdef DEBUG_IC_DMA_PIN
+/** @brief	Captures of each edge direction the dma rings hold */
+#define DEBUG_IC_DMA_SIZE	(128)
+/** @brief	Circular halfword transfers from the capture register */
+#define DEBUG_IC_DMA_CCR	(DMA_CCR_PL_1 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 \
+		| DMA_CCR_MINC | DMA_CCR_CIRC)
+#endif
+
 /* Private enums/structs ******************************************************/
 /** @brief  			enum for the type of gpio setting. */
 enum GPIO_IO_TYPE {
@@ -45,20 +66,59 @@ enum GPIO_IO_TYPE {
 	GPIO_INTERRUPT /**< gpio interrupts and saves event */
 };
 
+/** @brief				Edges captured by the timer of a DEBUG pin. */
+typedef struct {
+	uint64_t tick[DEBUG_IC_BUF_SIZE]; /**< Ticks of the edges */
+	uint8_t level[DEBUG_IC_BUF_SIZE]; /**< Levels after the edges */
+	volatile uint8_t wr; /**< Written by the capture interrupt */
+	uint8_t rd; /**< Read when polling */
+	volatile uint32_t lost; /**< Edges lost since the last poll */
+} debug_ic_buf_t;
+
+#ifdef DEBUG_IC_DMA_PIN
+/** @brief				Rings the capture dma of the DEBUG pin writes. */
+typedef struct {
+	uint16_t rise[DEBUG_IC_DMA_SIZE]; /**< Captures of the rising edges */
+	uint16_t fall[DEBUG_IC_DMA_SIZE]; /**< Captures of the falling edges */
+	uint16_t rise_rd; /**< Next rising capture to drain */
+	uint16_t fall_rd; /**< Next falling capture to drain */
+} debug_ic_dma_t;
+#endif
+
 /** @brief				Parameters for gpio control. */
 typedef struct {
 	GPIO_InitTypeDef hgpio; /**< handle for HAL gpio */
 	gpio_t *reg; /**< gpio application registers */
 	gpio_mode_t mode; /**< gpio mode */
 	GPIO_TypeDef *port; /**< port of gpio */
+	debug_ic_buf_t ic; /**< Captured edges */
 } gpio_dev;
 /** @} */
 
 /* Private function prototypes ************************************************/
 static error_t _commit_gpio(gpio_dev *dev);
+static error_t _commit_debug_ic();
+#ifdef DEBUG_IC_INST
+static void _capture_edge(uint8_t pin, uint32_t sr, uint64_t of_tick);
+#endif
+#ifdef DEBUG_IC_DMA_PIN
+static void _start_dma_capture();
+static void _stop_dma_capture();
+static void _drain_dma_capture();
+#endif
 
 /* Private variables **********************************************************/
 static gpio_dev debug_gpio[3];
+#ifdef DEBUG_IC_INST
+/** @brief	Pins capturing with the timer, bit n is DEBUGn */
+static uint8_t debug_ic_pins;
+/** @brief	Systick of the last capture timer overflow */
+static uint64_t debug_ic_of_tick;
+#endif
+#ifdef DEBUG_IC_DMA_PIN
+/** @brief	Captures of the pin with dma channels */
+static debug_ic_dma_t debug_ic_dma;
+#endif
 
 /******************************************************************************/
 /*           Initialization                                                   */
@@ -101,6 +161,10 @@ error_t commit_debug() {
 		return err;
 	}
 	err = _commit_gpio(&debug_gpio[2]);
+	if (err != 0) {
+		return err;
+	}
+	err = _commit_debug_ic();
 	EXTI->PR = DEBUG0_Pin | DEBUG1_Pin | DEBUG2_Pin;
 	HAL_NVIC_EnableIRQ(GPIO_DEBUG0_IRQ);
 	HAL_NVIC_EnableIRQ(GPIO_DEBUG1_IRQ);
@@ -127,11 +191,19 @@ static error_t _commit_gpio(gpio_dev *dev) {
 	} else if (dev->reg->mode.io_type == GPIO_INTERRUPT) {
 		dev->hgpio.Mode = GPIO_MODE_IT_RISING_FALLING;
 		dev->hgpio.Pull = dev->reg->mode.pull;
+		if (dev->reg->mode.capture) {
+#ifndef DEBUG_IC_INST
+			return EINVAL;
+#endif
+			/* The timer input needs the pin as input without the EXTI */
+			dev->hgpio.Mode = GPIO_MODE_INPUT;
+		}
 	} else {
 		return EINVAL;
 	}
 	dev->mode.io_type = dev->reg->mode.io_type;
 	dev->mode.tick_div = dev->reg->mode.tick_div;
+	dev->mode.capture = dev->reg->mode.capture;
 
 	dev->reg->mode.init = 1;
 
@@ -139,6 +211,180 @@ static error_t _commit_gpio(gpio_dev *dev) {
 	return 0;
 }
 
+/******************************************************************************/
+static error_t _commit_debug_ic() {
+#ifdef DEBUG_IC_INST
+	TIM_TypeDef *tmr = DEBUG_IC_INST;
+	uint8_t pins = 0;
+
+	for (uint8_t i = 0; i < 3; i++) {
+		if (debug_gpio[i].mode.io_type == GPIO_INTERRUPT
+				&& debug_gpio[i].mode.capture) {
+			pins |= 1 << i;
+		}
+	}
+	if (pins == debug_ic_pins) {
+		return 0;
+	}
+	/* Running without capturing pins means the SPI clock capture has it */
+	if (debug_ic_pins == 0 && (tmr->CR1 & TIM_CR1_CEN)) {
+		return EBUSY;
+	}
+	HAL_NVIC_DisableIRQ(DEBUG_IC_IRQ);
+	tmr->CR1 = 0;
+	tmr->DIER = 0;
+#ifdef DEBUG_IC_DMA_PIN
+	if (debug_ic_pins & (1 << DEBUG_IC_DMA_PIN)) {
+		_stop_dma_capture();
+	}
+#endif
+	/* Edges of pins that stop capturing are still merged into the trace */
+	poll_debug_ic();
+	debug_ic_pins = pins;
+	for (uint8_t i = 0; i < 3; i++) {
+		debug_gpio[i].reg->status.capture_dma = 0;
+	}
+	if (pins == 0) {
+		DEBUG_IC_CLK_DIS();
+		return 0;
+	}
+
+	DEBUG_IC_CLK_EN();
+	DEBUG_IC_AFIO_REMAP();
+	tmr->PSC = 0;
+	tmr->ARR = DEBUG_IC_PERIOD - 1;
+	tmr->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_0;
+	tmr->CCMR2 = TIM_CCMR2_CC3S_0;
+	tmr->CCER = 0;
+	tmr->DIER = TIM_DIER_UIE;
+	for (uint8_t i = 0; i < 3; i++) {
+		if (!(pins & (1 << i))) {
+			continue;
+		}
+		debug_gpio[i].ic.rd = debug_gpio[i].ic.wr;
+		debug_gpio[i].ic.lost = 0;
+		debug_gpio[i].reg->capture_lost = 0;
+#ifdef DEBUG_IC_DMA_PIN
+		if (i == DEBUG_IC_DMA_PIN) {
+			debug_gpio[i].reg->status.capture_dma = 1;
+			_start_dma_capture();
+			continue;
+		}
+#endif
+		/* Only one edge can be captured, the interrupt toggles it */
+		tmr->CCER |= TIM_CCER_CC1E << (4 * i);
+		if (HAL_GPIO_ReadPin(debug_gpio[i].port, debug_gpio[i].hgpio.Pin)) {
+			tmr->CCER |= TIM_CCER_CC1P << (4 * i);
+		}
+		tmr->DIER |= TIM_DIER_CC1IE << i;
+	}
+	tmr->EGR = TIM_EGR_UG;
+	tmr->SR = 0;
+
+	DIS_INT;
+	tmr->CR1 = TIM_CR1_CEN;
+	debug_ic_of_tick = get_tick64_div(0) - tmr->CNT;
+	EN_INT;
+	HAL_NVIC_SetPriority(DEBUG_IC_IRQ, DEFAULT_INT_PRIO, 0);
+	HAL_NVIC_EnableIRQ(DEBUG_IC_IRQ);
+#endif
+	return 0;
+}
+
+#ifdef DEBUG_IC_DMA_PIN
+/* Channel 3 latches the rising and channel 4 the falling edges of the same
+ * input so no edge waits for the cpu to flip the polarity */
+static void _start_dma_capture() {
+	TIM_TypeDef *tmr = DEBUG_IC_INST;
+
+	tmr->CCMR2 = TIM_CCMR2_CC3S_0 | TIM_CCMR2_CC4S_1;
+	tmr->CCER |= TIM_CCER_CC3E | TIM_CCER_CC4E | TIM_CCER_CC4P;
+	tmr->DIER |= TIM_DIER_CC3DE | TIM_DIER_CC4DE;
+	debug_ic_dma.rise_rd = 0;
+	debug_ic_dma.fall_rd = 0;
+
+	DEBUG_IC_RISE_DMA_INST->CCR = 0;
+	DEBUG_IC_RISE_DMA_INST->CPAR = (uint32_t)&(tmr->CCR3);
+	DEBUG_IC_RISE_DMA_INST->CMAR = (uint32_t)debug_ic_dma.rise;
+	DEBUG_IC_RISE_DMA_INST->CNDTR = DEBUG_IC_DMA_SIZE;
+	DEBUG_IC_FALL_DMA_INST->CCR = 0;
+	DEBUG_IC_FALL_DMA_INST->CPAR = (uint32_t)&(tmr->CCR4);
+	DEBUG_IC_FALL_DMA_INST->CMAR = (uint32_t)debug_ic_dma.fall;
+	DEBUG_IC_FALL_DMA_INST->CNDTR = DEBUG_IC_DMA_SIZE;
+	DMA1->IFCR = DEBUG_IC_DMA_FLAGS;
+	/* Edges alternate so the rising ring drains often enough for both */
+	DEBUG_IC_RISE_DMA_INST->CCR = DEBUG_IC_DMA_CCR | DMA_CCR_HTIE
+			| DMA_CCR_TCIE | DMA_CCR_EN;
+	DEBUG_IC_FALL_DMA_INST->CCR = DEBUG_IC_DMA_CCR | DMA_CCR_EN;
+	HAL_NVIC_SetPriority(DEBUG_IC_DMA_IRQ, DEFAULT_INT_PRIO, 0);
+	HAL_NVIC_EnableIRQ(DEBUG_IC_DMA_IRQ);
+}
+
+/* The timer is already stopped so the captures left in the rings are final */
+static void _stop_dma_capture() {
+	HAL_NVIC_DisableIRQ(DEBUG_IC_DMA_IRQ);
+	_drain_dma_capture();
+	DEBUG_IC_RISE_DMA_INST->CCR = 0;
+	DEBUG_IC_FALL_DMA_INST->CCR = 0;
+	DMA1->IFCR = DEBUG_IC_DMA_FLAGS;
+}
+
+/* Moves the captures to the edge buffer of the pin oldest first, a capture is
+ * resolved against the count read after the rings so it must be less than a
+ * timer period old, the overflow interrupt drains once per period so only a
+ * capture right after a drain can miss this if the next overflow interrupt is
+ * served later than the previous one */
+static void _drain_dma_capture() {
+	TIM_TypeDef *tmr = DEBUG_IC_INST;
+	debug_ic_buf_t *ic = &debug_gpio[DEBUG_IC_DMA_PIN].ic;
+	uint16_t rise_wr = (DEBUG_IC_DMA_SIZE - DEBUG_IC_RISE_DMA_INST->CNDTR)
+			% DEBUG_IC_DMA_SIZE;
+	uint16_t fall_wr = (DEBUG_IC_DMA_SIZE - DEBUG_IC_FALL_DMA_INST->CNDTR)
+			% DEBUG_IC_DMA_SIZE;
+	uint16_t cnt = tmr->CNT;
+	uint64_t now = debug_ic_of_tick + cnt;
+
+	if ((tmr->SR & TIM_SR_UIF) && cnt < DEBUG_IC_PERIOD / 2) {
+		now += DEBUG_IC_PERIOD;
+	}
+	while (debug_ic_dma.rise_rd != rise_wr
+			|| debug_ic_dma.fall_rd != fall_wr) {
+		uint64_t rise_tick = UINT64_MAX;
+		uint64_t fall_tick = UINT64_MAX;
+		uint64_t tick;
+		uint8_t level;
+
+		if (debug_ic_dma.rise_rd != rise_wr) {
+			rise_tick = now - (uint16_t)(cnt
+					- debug_ic_dma.rise[debug_ic_dma.rise_rd]);
+		}
+		if (debug_ic_dma.fall_rd != fall_wr) {
+			fall_tick = now - (uint16_t)(cnt
+					- debug_ic_dma.fall[debug_ic_dma.fall_rd]);
+		}
+		if (rise_tick < fall_tick) {
+			tick = rise_tick;
+			level = 1;
+			debug_ic_dma.rise_rd = (debug_ic_dma.rise_rd + 1)
+					% DEBUG_IC_DMA_SIZE;
+		}
+		else {
+			tick = fall_tick;
+			level = 0;
+			debug_ic_dma.fall_rd = (debug_ic_dma.fall_rd + 1)
+					% DEBUG_IC_DMA_SIZE;
+		}
+		if ((uint8_t)(ic->wr - ic->rd) >= DEBUG_IC_BUF_SIZE) {
+			ic->lost++;
+			continue;
+		}
+		ic->tick[ic->wr % DEBUG_IC_BUF_SIZE] = tick;
+		ic->level[ic->wr % DEBUG_IC_BUF_SIZE] = level;
+		ic->wr++;
+	}
+}
+#endif
+
 /******************************************************************************/
 error_t init_basic_gpio(basic_gpio_t gpio, GPIO_TypeDef *port, uint32_t pin) {
 	GPIO_InitTypeDef hgpio = {0};
@@ -175,6 +421,60 @@ void update_debug_inputs() {
 		}
 	}
 }
+
+void poll_debug_ic() {
+	for (uint8_t i = 0; i < 3; i++) {
+		debug_ic_buf_t *ic = &debug_gpio[i].ic;
+		uint32_t lost;
+
+		if (ic->lost) {
+			DIS_INT;
+			lost = ic->lost;
+			ic->lost = 0;
+			EN_INT;
+			debug_gpio[i].reg->capture_lost += lost;
+			drop_trace(SOURCE_DEBUG0 + i, lost);
+		}
+	}
+	/* Merge the pins oldest edge first */
+	while (1) {
+		debug_ic_buf_t *next = NULL;
+		uint8_t source = SOURCE_NONE;
+		uint8_t index;
+
+		for (uint8_t i = 0; i < 3; i++) {
+			debug_ic_buf_t *ic = &debug_gpio[i].ic;
+
+			if (ic->rd == ic->wr) {
+				continue;
+			}
+			if (next == NULL || ic->tick[ic->rd % DEBUG_IC_BUF_SIZE]
+					< next->tick[next->rd % DEBUG_IC_BUF_SIZE]) {
+				next = ic;
+				source = SOURCE_DEBUG0 + i;
+			}
+		}
+		if (next == NULL) {
+			break;
+		}
+		index = next->rd % DEBUG_IC_BUF_SIZE;
+		store_tick_from_buf(source, next->level[index], next->tick[index]);
+		next->rd++;
+	}
+}
+
+uint8_t get_debug_ic_fill() {
+	uint8_t waiting = 0;
+
+	for (uint8_t i = 0; i < 3; i++) {
+		debug_ic_buf_t *ic = &debug_gpio[i].ic;
+
+		if ((uint8_t)(ic->wr - ic->rd) > waiting) {
+			waiting = ic->wr - ic->rd;
+		}
+	}
+	return waiting * 100 / DEBUG_IC_BUF_SIZE;
+}
 /******************************************************************************/
 /*           Interrupt Handling                                               */
 /******************************************************************************/
@@ -205,3 +505,70 @@ void GPIO_DEBUG2_INT() {
 	EXTI->PR = DEBUG2_Pin;
 }
 
+#ifdef DEBUG_IC_INST
+/**
+ * @brief 	Interrupt of the timer capturing the DEBUG pins
+ */
+void DEBUG_IC_INT() {
+	TIM_TypeDef *tmr = DEBUG_IC_INST;
+	uint32_t sr = tmr->SR;
+
+	/* Flags set after reading are handled by the next interrupt */
+	tmr->SR = ~sr;
+	for (uint8_t i = 0; i < 3; i++) {
+		if (sr & (TIM_SR_CC1IF << i)) {
+			_capture_edge(i, sr, debug_ic_of_tick);
+		}
+	}
+	if (sr & TIM_SR_UIF) {
+		debug_ic_of_tick += DEBUG_IC_PERIOD;
+#ifdef DEBUG_IC_DMA_PIN
+		if (debug_ic_pins & (1 << DEBUG_IC_DMA_PIN)) {
+			_drain_dma_capture();
+		}
+#endif
+	}
+}
+
+#ifdef DEBUG_IC_DMA_PIN
+/**
+ * @brief 	Interrupt of the rising capture dma every half ring
+ */
+void DEBUG_IC_DMA_INT() {
+	DMA1->IFCR = DEBUG_IC_DMA_FLAGS;
+	_drain_dma_capture();
+}
+#endif
+
+static void _capture_edge(uint8_t pin, uint32_t sr, uint64_t of_tick) {
+	TIM_TypeDef *tmr = DEBUG_IC_INST;
+	debug_ic_buf_t *ic = &debug_gpio[pin].ic;
+	uint32_t polarity = TIM_CCER_CC1P << (4 * pin);
+	uint16_t ccr = (&tmr->CCR1)[pin];
+	uint8_t level = !(tmr->CCER & polarity);
+
+	/* A small capture with a pending overflow happened after the overflow */
+	if ((sr & TIM_SR_UIF) && ccr < DEBUG_IC_PERIOD / 2) {
+		of_tick += DEBUG_IC_PERIOD;
+	}
+	if (sr & (TIM_SR_CC1OF << pin)) {
+		ic->lost++;
+	}
+	/* Wait for the other edge unless it already passed */
+	if (HAL_GPIO_ReadPin(debug_gpio[pin].port, debug_gpio[pin].hgpio.Pin)
+			== level) {
+		tmr->CCER ^= polarity;
+	}
+	else {
+		ic->lost++;
+	}
+	if ((uint8_t)(ic->wr - ic->rd) >= DEBUG_IC_BUF_SIZE) {
+		ic->lost++;
+		return;
+	}
+	ic->tick[ic->wr % DEBUG_IC_BUF_SIZE] = of_tick + ccr;
+	ic->level[ic->wr % DEBUG_IC_BUF_SIZE] = level;
+	ic->wr++;
+}
+#endif
+
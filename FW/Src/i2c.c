@@ -29,6 +29,7 @@
 #include "app_common.h"
 #include "app_defaults.h"
 #include "app_reg.h"
+#include "prof.h"
 
 #include "gpio.h"
 
@@ -189,7 +190,10 @@ void update_dut_i2c_inputs() {
  * @brief This function handles i2c_dut event interrupt.
  */
 void DUT_I2C_EV_INT(void) {
+	PROF_START(PROF_I2C_IT);
 	_i2c_it(&dut_i2c);
+	PROF_END(PROF_I2C_IT);
+	REG_SNAP_CHANGED(REG_SNAP_I2C);
 }
 
 /**
@@ -197,6 +201,7 @@ void DUT_I2C_EV_INT(void) {
  */
 void DUT_I2C_ERR_INT(void) {
 	_i2c_err(&dut_i2c);
+	REG_SNAP_CHANGED(REG_SNAP_I2C);
 }
 
 /******************************************************************************/
@@ -65,17 +65,64 @@
 #include "wdt.h"
 #include "tmr.h"
 #include "port.h"
+#include "sched.h"
+#include "prof.h"
+
+/* Private defines ************************************************************/
+/** @brief	Period of updating the input registers in ms */
+#define INPUT_PERIOD_MS	(10)
 
 /* Private function prototypes ************************************************/
-static uint32_t _is_tick();
-static void _super_loop();
+static void _poll_dut_uart();
+static void _poll_if_uart();
+
+/* Private variables **********************************************************/
+/**
+ * @brief	Tasks run by the scheduler
+ * @note	The order matches the sched.task statistics in the register map,
+ * 			budgets are in us.
+ */
+static const sched_task_t tasks[] = {
+	{.fxn = reset_wdt, .period = 1, .priority = 0, .budget = 10},
+	{.fxn = flash_fw_version, .period = 1, .priority = 1, .budget = 10},
+	{.fxn = update_tick, .period = INPUT_PERIOD_MS, .priority = 2, .budget = 10},
+	{.fxn = update_debug_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_dut_spi_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_dut_i2c_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_dut_uart_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_dut_pwm_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_dut_dac_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_dut_ic_inputs, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+	{.fxn = update_rtc, .period = INPUT_PERIOD_MS, .priority = 2, .budget = 50},
+	/* DMA drains run first on every pass and between the other tasks once
+	 * their buffers fill */
+	{.fxn = poll_dut_ic, .period = 0, .priority = 0, .budget = 200,
+			.fill = get_dut_ic_fill},
+	{.fxn = poll_dut_spi_ic, .period = 0, .priority = 0, .budget = 200,
+			.fill = get_dut_spi_ic_fill},
+	{.fxn = poll_dut_adc, .period = 0, .priority = 1, .budget = 50},
+	{.fxn = _poll_dut_uart, .period = 0, .priority = 2, .budget = 500},
+	{.fxn = _poll_if_uart, .period = 0, .priority = 2, .budget = 2000},
+	{.fxn = poll_debug_ic, .period = 0, .priority = 0, .budget = 200,
+			.fill = get_debug_ic_fill},
+	{.fxn = check_stack_guard, .period = INPUT_PERIOD_MS, .priority = 2,
+			.budget = 20},
+};
 
 /******************************************************************************/
 /*           Functions                                                        */
 /******************************************************************************/
 /** @brief  The application entry point. */
 int main(void) {
-	map_t reg = { 0 };
+	/* The map is larger than the stack so it is kept with the static data */
+	static map_t reg = { 0 };
 
 	/* Reset of all peripherals, Initializes the Flash interface and Systick. */
 	HAL_Init();
@@ -92,62 +139,28 @@ int main(void) {
 	init_trace(&reg);
 	init_dut_pwm_dac(&reg);
 	init_dut_uart(&reg);
-	init_if_uart();
+	init_if_uart(&reg);
 	init_dut_i2c(&reg);
 	init_dut_spi(&reg);
 	init_rtc(&reg);
 	init_dut_adc(&reg);
 	init_dut_ic(&reg);
 	init_sys(&reg);
+	init_prof(&reg);
 	init_led_flash();
 	init_wdt();
+	init_sched(&reg, tasks, sizeof(tasks) / sizeof(tasks[0]));
 	EN_INT;
 	while (1) {
-		_super_loop();
-		poll_dut_uart();
-		poll_if_uart();
+		run_sched();
 	}
 }
 
 /******************************************************************************/
-static void _super_loop() {
-	void (* const fxn_to_ex_per_tick[])(void) = {update_tick,
-		update_debug_inputs,
-		update_dut_spi_inputs,
-		update_dut_i2c_inputs,
-		update_dut_uart_inputs,
-		update_dut_pwm_inputs,
-		update_dut_dac_inputs,
-		update_dut_ic_inputs,
-		update_rtc };
-	void (* const fxn_to_ex[])(void) = {poll_dut_adc,
-										poll_dut_ic,
-										poll_dut_spi_ic};
-	static uint32_t fxn_index_tick = 0;
-	static uint32_t fxn_index = 0;
-	if (_is_tick()) {
-		flash_fw_version();
-		reset_wdt();
-		(fxn_to_ex_per_tick[fxn_index_tick++])();
-		if (fxn_index_tick
-				>= sizeof(fxn_to_ex_per_tick) / sizeof(fxn_to_ex_per_tick[0])) {
-			fxn_index_tick = 0;
-		}
-	} else {
-		(fxn_to_ex[fxn_index++])();
-		if (fxn_index >= sizeof(fxn_to_ex) / sizeof(fxn_to_ex[0])) {
-			fxn_index = 0;
-		}
-	}
+static void _poll_dut_uart() {
+	poll_dut_uart();
 }
 
-/******************************************************************************/
-static uint32_t _is_tick() {
-	static uint32_t tick = 0;
-	if (tick != HAL_GetTick()) {
-
-		tick = HAL_GetTick();
-		return 1;
-	}
-	return 0;
+static void _poll_if_uart() {
+	poll_if_uart();
 }
@@ -169,6 +169,25 @@ void HAL_TIM_IC_MspDeInit(TIM_HandleTypeDef* htim) {
 	}
 }
 
+/******************************************************************************/
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim) {
+	if (htim->Instance == DUT_IC_INST) {
+		dut_ic_half_cplt();
+	}
+	else if (htim->Instance == DUT_SPI_IC_INST) {
+		dut_spi_ic_half_cplt();
+	}
+}
+
+void HAL_TIM_IC_CaptureHalfCpltCallback(TIM_HandleTypeDef *htim) {
+	if (htim->Instance == DUT_IC_INST) {
+		dut_ic_half_cplt();
+	}
+	else if (htim->Instance == DUT_SPI_IC_INST) {
+		dut_spi_ic_half_cplt();
+	}
+}
+
 /******************************************************************************/
 void HAL_TIM_PWM_MspInit(TIM_HandleTypeDef* htim) {
 	if (htim->Instance == DUT_PWM_DAC_INST) {
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup Application
+ * @{
+ * @file			prof.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Cycle count profiling of hot paths.
+ * @details			The aggregation in update_prof_entry() does not depend on
+ * 					the hardware so it can be tested on a host.
+ * @}
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <errno.h>
+#include <stdint.h>
+
+#include "stm32f1xx_hal.h"
+
+#include "mm_typedefs.h"
+#include "app_reg.h"
+
+#include "prof.h"
+
+/* Private defines ************************************************************/
+/** @brief		The amount of profile entries in the register map. */
+#define NUM_OF_ENTRIES	(sizeof(((map_t*)0)->prof.entry)/sizeof(((map_t*)0)->prof.entry[0]))
+
+/* Private variables **********************************************************/
+static prof_t *prof;
+
+/******************************************************************************/
+/*           Initialization                                                   */
+/******************************************************************************/
+void init_prof(map_t *reg) {
+	prof = &(reg->prof);
+#if defined(PHILIP_PROFILE) && defined(DWT)
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/******************************************************************************/
+/*           Functions                                                        */
+/******************************************************************************/
+void record_prof(uint8_t id, uint32_t cycles) {
+	if (id >= NUM_OF_ENTRIES) {
+		return;
+	}
+	update_prof_entry(&prof->entry[id], cycles);
+	REG_SNAP_CHANGED(REG_SNAP_PROF);
+}
+
+void update_prof_entry(prof_entry_t *entry, uint32_t cycles) {
+	if (entry->call_count == 0) {
+		entry->min_cycles = UINT32_MAX;
+		entry->max_cycles = 0;
+		entry->total_cycles = 0;
+	}
+	entry->call_count++;
+	entry->total_cycles += cycles;
+	if (entry->min_cycles > cycles) {
+		entry->min_cycles = cycles;
+	}
+	if (entry->max_cycles < cycles) {
+		entry->max_cycles = cycles;
+	}
+	entry->mean_cycles = (uint32_t)(entry->total_cycles / entry->call_count);
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup Application
+ * @{
+ * @file			sched.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Cooperative task scheduler for the polling functions.
+ * @}
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "stm32f1xx_hal.h"
+
+#include "mm_typedefs.h"
+
+#include "sched.h"
+
+/* Private defines ************************************************************/
+/** @brief		The amount of tasks with statistics in the register map. */
+#define NUM_OF_TASKS	(sizeof(((map_t*)0)->sched.task)/sizeof(((map_t*)0)->sched.task[0]))
+
+/* Private variables **********************************************************/
+static sched_t *sched;
+static const sched_task_t *tasks;
+static uint8_t task_count;
+/** @brief		Task indexes sorted by priority */
+static uint8_t order[NUM_OF_TASKS];
+/** @brief		The tick in ms when each periodic task is due */
+static uint32_t next_run[NUM_OF_TASKS];
+
+/* Private function prototypes ************************************************/
+static uint32_t _get_cycles();
+static void _run_task(uint8_t index);
+static void _run_boosted();
+
+/******************************************************************************/
+/*           Initialization                                                   */
+/******************************************************************************/
+void init_sched(map_t *reg, const sched_task_t *task_list, uint8_t count) {
+	uint32_t tick = HAL_GetTick();
+
+	sched = &(reg->sched);
+	tasks = task_list;
+	task_count = count;
+	if (task_count > NUM_OF_TASKS) {
+		task_count = NUM_OF_TASKS;
+	}
+	for (int i = 0; i < task_count; i++) {
+		int j = i;
+
+		while (j > 0 && tasks[order[j - 1]].priority > tasks[i].priority) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = i;
+		/* Spreads out the first runs of tasks with the same period */
+		next_run[i] = tick + i;
+	}
+}
+
+/******************************************************************************/
+/*           Functions                                                        */
+/******************************************************************************/
+void run_sched() {
+	uint32_t start = _get_cycles();
+	uint32_t tick = HAL_GetTick();
+	int due = -1;
+	uint32_t ticks;
+
+	/* Highest priority first, the earliest deadline within a priority */
+	for (int i = 0; i < task_count; i++) {
+		uint8_t index = order[i];
+
+		if (tasks[index].period == 0 || (int32_t)(tick - next_run[index]) < 0) {
+			continue;
+		}
+		if (due < 0) {
+			due = index;
+		} else if (tasks[index].priority != tasks[due].priority) {
+			break;
+		} else if ((int32_t)(next_run[index] - next_run[due]) < 0) {
+			due = index;
+		}
+	}
+	if (due >= 0) {
+		next_run[due] += tasks[due].period;
+		if ((int32_t)(tick - next_run[due]) >= 0) {
+			/* Missed a whole period, the missed runs are dropped */
+			sched->task[due].overruns++;
+			next_run[due] = tick + tasks[due].period;
+		}
+		_run_task(due);
+		_run_boosted();
+	}
+	for (int i = 0; i < task_count; i++) {
+		if (tasks[order[i]].period == 0) {
+			_run_task(order[i]);
+			_run_boosted();
+		}
+	}
+
+	ticks = _get_cycles() - start;
+	if (sched->max_loop_ticks < ticks) {
+		sched->max_loop_ticks = ticks;
+	}
+}
+
+static void _run_task(uint8_t index) {
+	task_t *stat = &(sched->task[index]);
+	uint32_t start = _get_cycles();
+	uint32_t ticks;
+
+	tasks[index].fxn();
+
+	ticks = _get_cycles() - start;
+	stat->run_count++;
+	if (stat->max_ticks < ticks) {
+		stat->max_ticks = ticks;
+	}
+	if (tasks[index].budget != 0 &&
+			ticks > tasks[index].budget * (SystemCoreClock / 1000000)) {
+		stat->overruns++;
+	}
+}
+
+/* Drains filling up faster than the pass runs them get a turn after every
+ * task, a long task in between cannot overflow them */
+static void _run_boosted() {
+	for (int i = 0; i < task_count; i++) {
+		if (tasks[i].fill != NULL && tasks[i].fill() >= SCHED_BOOST_FILL) {
+			_run_task(i);
+		}
+	}
+}
+
+/******************************************************************************/
+static uint32_t _get_cycles() {
+	uint32_t sys_tick;
+	uint32_t tick;
+
+	do {
+		sys_tick = SysTick->VAL;
+		tick = HAL_GetTick();
+	} while (SysTick->VAL > sys_tick);
+	/* Wraps around but differences are still correct */
+	return tick * (SysTick->LOAD + 1) + (SysTick->LOAD - sys_tick);
+}
@@ -24,14 +24,32 @@
 #include "stm32f1xx_hal.h"
 
 #include "mm_typedefs.h"
+#include "mm_default_philip_map.h"
 #include "port.h"
 #include "mm_access_types.h"
 #include "app_common.h"
 #include "app_reg.h"
+#include "prof.h"
 #include "gpio.h"
 
 #include "spi.h"
 
+/* Private defines ************************************************************/
+/** @brief	Checks the write direction */
+#define SPI_ADDR_MASK	(0x80)
+#define BITS_PER_BYTE	8
+/** @brief	Bytes of a dma write frame or the sniffed MOSI ring, must be a
+ * 			power of 2 */
+#define SPI_DMA_BUF_SIZE	(256)
+/** @brief	Edges in the clock capture buffer, must be a power of 2 */
+#define SPI_IC_BUF_SIZE		(128)
+/** @brief	Frame ends waiting for the poll, must be a power of 2 */
+#define SPI_IC_FRAME_SIZE	(8)
+/** @brief	Bytes of packed MISO samples of the sniffer, one bit per sample */
+#define SPI_SNIFF_BITS_SIZE	(256)
+/** @brief	Sniffed frames waiting for the drain */
+#define SPI_SNIFF_FRAME_SIZE	(16)
+
 /* Private enums/structs ******************************************************/
 /** @brief  							The state settings of the SPI */
 enum SPI_STATE {
@@ -49,9 +67,21 @@ enum SPI_IF_TYPE {
 	SPI_IF_TYPE_HS, /**< Preloads reg address to 0 for high speed tests */
 	SPI_IF_TYPE_ECHO, /**< Echos SPI bytes */
 	SPI_IF_TYPE_CONST, /**< Always output user reg 0 */
-	SPI_IF_TYPE_SM /**< Use timer input capture to measure spi clock speed */
+	SPI_IF_TYPE_SM, /**< Use timer input capture to measure spi clock speed */
+	SPI_IF_TYPE_DMA, /**< Access registers with dma, writes applied on NSS */
+	SPI_IF_TYPE_SNIFF /**< Records frames of other devices on the bus */
 };
 
+/** @brief	A frame recorded by the sniffer */
+typedef struct {
+	uint64_t tick; /**< Tick when NSS lowered */
+	uint32_t duration; /**< Ticks until NSS raised */
+	uint32_t mosi_pos; /**< Absolute position of the first MOSI byte */
+	uint32_t bit_pos; /**< Absolute position of the first MISO sample */
+	uint16_t size; /**< Bytes of the frame */
+	uint16_t flags; /**< SPI_SNIFF_FLAG of the frame */
+} spi_sniff_frame_t;
+
 /** @brief	The parameters for spi control */
 typedef struct {
 	SPI_HandleTypeDef hspi; /**< Handle for the spi device */
@@ -59,18 +89,44 @@ typedef struct {
 	DMA_HandleTypeDef htmr_dma; /**< Handle for the tmr dma */
 	TIM_IC_InitTypeDef ctmr_ic; /**< Initialization for timer */
 	spi_t *reg; /**< spi live application registers */
-	uint16_t buf[64]; /**< Buffer for DMA */
-	int8_t poll_index; /**< Buffer index when polling */
+	DMA_HandleTypeDef hrx_dma; /**< Handle for the register receive dma */
+	DMA_HandleTypeDef htx_dma; /**< Handle for the register transmit dma */
+	const uint8_t *map_data; /**< Register map the transmit dma reads */
+	uint16_t buf[SPI_IC_BUF_SIZE]; /**< Circular buffer of the clock dma */
+	uint8_t rx_buf[SPI_DMA_BUF_SIZE]; /**< Staging of the dma writes */
+	uint32_t half_pos; /**< Absolute position of the last filled half */
+	uint32_t rd_pos; /**< Absolute position of the next edge to measure */
+	uint32_t frame_pos; /**< Absolute position of the current frame */
+	uint32_t frame_end[SPI_IC_FRAME_SIZE]; /**< Positions after the frames */
+	volatile uint8_t frame_wr; /**< Next frame end to latch */
+	uint8_t frame_rd; /**< Next frame end to pass */
+	uint16_t prev_val; /**< Capture of the previous edge */
+	uint16_t prev_bit; /**< Previous bit period */
+	uint32_t frame_bit_sum; /**< Bit periods of the frame in ticks */
+	uint32_t frame_bits; /**< Bit periods of the frame */
+	uint32_t frame_ticks; /**< Ticks between the edges of the frame */
+	uint32_t frame_edges; /**< Edge differences in frame_ticks */
+	uint32_t byte_sum; /**< Bit periods of the byte in ticks */
+	uint8_t byte_bits; /**< Bit periods of the byte */
+	uint8_t has_prev; /**< The previous edge is in the same frame */
 	void (*if_mode_int)(void); /**< Interrupt function pointer */
 	uint8_t initial_byte; /**< The byte that is output first */
 	uint8_t sm_active;
+	uint8_t dma_active; /**< The dma channels are claimed by the spi */
+	spi_sniff_frame_t sniff[SPI_SNIFF_FRAME_SIZE]; /**< Frames to drain */
+	uint8_t miso_bits[SPI_SNIFF_BITS_SIZE]; /**< MISO samples, msb first */
+	uint64_t sniff_tick; /**< Tick when NSS lowered */
+	uint32_t sniff_edge; /**< Capture position when NSS lowered */
+	uint32_t mosi_pos; /**< Absolute MOSI position after the last frame */
+	uint32_t bit_pos; /**< Absolute position of the next sample to pack */
+	uint32_t bit_valid; /**< Samples before this position were skipped */
+	uint16_t sniff_rd; /**< Oldest frame in the ring */
+	uint16_t sniff_level; /**< Frames in the ring */
+	uint16_t sniff_ack; /**< Drain position of the oldest frame */
+	uint8_t sniff_active; /**< The clock capture samples MISO */
 } spi_dev;
 /** @} */
 
-/* Private defines ************************************************************/
-/** @brief	Checks the write direction */
-#define SPI_ADDR_MASK	(0x80)
-#define BITS_PER_BYTE	8
 
 /* Private function prototypes ************************************************/
 static void _init_gpio();
@@ -79,6 +135,24 @@ static void _spi_echo_int();
 static void _spi_hs_int();
 static void _spi_reg_int();
 static void _spi_const_int();
+static void _spi_dma_int();
+static void _start_dma();
+static void _stop_dma();
+static void _finish_dma_frame();
+#ifdef DUT_SPI_TX_DMA_SHARED
+void DUT_UART_DMA_RX_INT(void);
+#endif
+static void _start_sniff(uint32_t polarity);
+static void _pack_miso(uint32_t pos);
+static void _latch_sniff_frame();
+static uint16_t _pack_sniff_frame(uint8_t *buf, uint16_t max_size,
+		const spi_sniff_frame_t *frame, uint8_t first);
+static uint32_t _get_ic_position();
+static void _latch_frame_end();
+static void _skip_lost(uint32_t pos);
+static void _measure_edges(uint32_t pos);
+static void _start_sm_frame();
+static void _add_bit(uint32_t n, uint16_t diff);
 static void _init_periph_spi_ic();
 static void _deinit_periph_spi_ic(TIM_HandleTypeDef *htmr);
 
@@ -105,6 +179,7 @@ void init_dut_spi(map_t *reg) {
 	hspi->Init.CRCPolynomial = 0;
 
 	dut_spi.reg = &(reg->spi);
+	dut_spi.map_data = reg->data;
 	commit_dut_spi();
 }
 
@@ -193,13 +268,14 @@ static void _init_periph_spi_ic() {
 }
 
 static void _deinit_periph_spi_ic(TIM_HandleTypeDef *htmr){
-	if(dut_spi.sm_active){
+	if(dut_spi.sm_active || dut_spi.sniff_active){
 		HAL_TIM_IC_Stop_DMA(htmr, DUT_SPI_IC_CHANNEL);
 		if (HAL_TIM_Base_DeInit(htmr) != HAL_OK) {
 			_Error_Handler(__FILE__, __LINE__);
 		}
 		_init_gpio();
 		dut_spi.sm_active = 0;
+		dut_spi.sniff_active = 0;
 	}
 }
 
@@ -225,7 +301,7 @@ void init_dut_spi_ic_msp() {
 	htmr_dma->Init.MemInc = DMA_MINC_ENABLE;
 	htmr_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
 	htmr_dma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
-	htmr_dma->Init.Mode = DMA_NORMAL;
+	htmr_dma->Init.Mode = DMA_CIRCULAR;
 	htmr_dma->Init.Priority = DMA_PRIORITY_LOW;
 	if (HAL_DMA_Init(htmr_dma) != HAL_OK) {
 		_Error_Handler(__FILE__, __LINE__);
@@ -246,6 +322,106 @@ void deinit_dut_spi_ic_msp() {
 	HAL_NVIC_DisableIRQ(DUT_SPI_IC_INT);
 }
 
+/******************************************************************************/
+/* Claims both channels, they stay enabled while the mode is committed so the
+ * other users of the channels see them as busy, the requests are only enabled
+ * during a frame */
+static void _start_dma() {
+	DMA_HandleTypeDef *hrx_dma = &(dut_spi.hrx_dma);
+	DMA_HandleTypeDef *htx_dma = &(dut_spi.htx_dma);
+
+	hrx_dma->Instance = DUT_SPI_RX_DMA_INST;
+	hrx_dma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hrx_dma->Init.PeriphInc = DMA_PINC_DISABLE;
+	hrx_dma->Init.MemInc = DMA_MINC_ENABLE;
+	hrx_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hrx_dma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hrx_dma->Init.Mode = DMA_NORMAL;
+	hrx_dma->Init.Priority = DMA_PRIORITY_VERY_HIGH;
+	if (HAL_DMA_Init(hrx_dma) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	htx_dma->Instance = DUT_SPI_TX_DMA_INST;
+	htx_dma->Init = hrx_dma->Init;
+	htx_dma->Init.Direction = DMA_MEMORY_TO_PERIPH;
+	if (HAL_DMA_Init(htx_dma) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+
+	DUT_SPI_RX_DMA_INST->CPAR = (uint32_t)&(dut_spi.hspi.Instance->DR);
+	DUT_SPI_RX_DMA_INST->CMAR = (uint32_t)dut_spi.rx_buf;
+	DUT_SPI_RX_DMA_INST->CNDTR = SPI_DMA_BUF_SIZE;
+	DUT_SPI_RX_DMA_INST->CCR |= DMA_CCR_EN;
+
+	DUT_SPI_TX_DMA_INST->CPAR = (uint32_t)&(dut_spi.hspi.Instance->DR);
+	DUT_SPI_TX_DMA_INST->CMAR = (uint32_t)dut_spi.map_data;
+	DUT_SPI_TX_DMA_INST->CNDTR = 1;
+	DUT_SPI_TX_DMA_INST->CCR |= DMA_CCR_EN;
+	HAL_NVIC_SetPriority(DUT_SPI_TX_DMA_IRQ, DEFAULT_INT_PRIO, 0);
+	HAL_NVIC_EnableIRQ(DUT_SPI_TX_DMA_IRQ);
+	dut_spi.dma_active = 1;
+}
+
+/* Releases the channels if the spi has claimed them, the sniffer only claims
+ * the receive channel */
+static void _stop_dma() {
+	if (dut_spi.dma_active) {
+		CLEAR_BIT(dut_spi.hspi.Instance->CR2,
+				SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+		HAL_DMA_DeInit(&(dut_spi.hrx_dma));
+		if (dut_spi.htx_dma.State != HAL_DMA_STATE_RESET) {
+			HAL_DMA_DeInit(&(dut_spi.htx_dma));
+		}
+		dut_spi.dma_active = 0;
+	}
+}
+
+/* The MOSI bytes go to a circular dma, the clock capture copies the MISO port
+ * instead of the timer on every sampling edge */
+static void _start_sniff(uint32_t polarity) {
+	TIM_HandleTypeDef *htmr = &(dut_spi.htmr);
+	TIM_IC_InitTypeDef* ctmr_ic = &(dut_spi.ctmr_ic);
+	DMA_HandleTypeDef *hrx_dma = &(dut_spi.hrx_dma);
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	/* The receive only slave does not drive MISO */
+	GPIO_InitStruct.Pin = DUT_MISO_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(DUT_MISO_GPIO_Port, &GPIO_InitStruct);
+
+	hrx_dma->Instance = DUT_SPI_RX_DMA_INST;
+	hrx_dma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hrx_dma->Init.PeriphInc = DMA_PINC_DISABLE;
+	hrx_dma->Init.MemInc = DMA_MINC_ENABLE;
+	hrx_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hrx_dma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hrx_dma->Init.Mode = DMA_CIRCULAR;
+	hrx_dma->Init.Priority = DMA_PRIORITY_VERY_HIGH;
+	if (HAL_DMA_Init(hrx_dma) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	DUT_SPI_RX_DMA_INST->CPAR = (uint32_t)&(dut_spi.hspi.Instance->DR);
+	DUT_SPI_RX_DMA_INST->CMAR = (uint32_t)dut_spi.rx_buf;
+	DUT_SPI_RX_DMA_INST->CNDTR = SPI_DMA_BUF_SIZE;
+	DUT_SPI_RX_DMA_INST->CCR |= DMA_CCR_EN;
+	SET_BIT(dut_spi.hspi.Instance->CR2, SPI_CR2_RXDMAEN);
+	dut_spi.dma_active = 1;
+
+	_init_periph_spi_ic();
+	ctmr_ic->ICPolarity = polarity;
+	if (HAL_TIM_IC_ConfigChannel(htmr, ctmr_ic, DUT_SPI_IC_CHANNEL) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	if (HAL_TIM_IC_Start_DMA(htmr, DUT_SPI_IC_CHANNEL, (uint32_t*)dut_spi.buf, SPI_IC_BUF_SIZE) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	DUT_SPI_IC_DMA_INST->CCR &= ~DMA_CCR_EN;
+	DUT_SPI_IC_DMA_INST->CPAR = (uint32_t)&(DUT_MISO_GPIO_Port->IDR);
+	DUT_SPI_IC_DMA_INST->CCR |= DMA_CCR_EN;
+	dut_spi.sniff_active = 1;
+}
+
 /******************************************************************************/
 static void _init_gpio() {
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
@@ -268,7 +444,35 @@ error_t commit_dut_spi() {
 	if (reg->mode.init) {
 		return 0;
 	}
+	/* The timer of the clock capture may be capturing the DEBUG pins */
+	if ((reg->mode.if_type == SPI_IF_TYPE_SM
+			|| reg->mode.if_type == SPI_IF_TYPE_SNIFF) && !reg->mode.disable
+			&& !dut_spi.sm_active && !dut_spi.sniff_active
+			&& (DUT_SPI_IC_INST->CR1 & TIM_CR1_CEN)) {
+		return EBUSY;
+	}
+	/* The dma channels are shared with DUT_IC and some uarts */
+	if (reg->mode.if_type == SPI_IF_TYPE_DMA && !reg->mode.disable
+			&& !dut_spi.dma_active
+			&& ((DUT_SPI_RX_DMA_INST->CCR | DUT_SPI_TX_DMA_INST->CCR)
+					& DMA_CCR_EN)) {
+		return EBUSY;
+	}
+	if (reg->mode.if_type == SPI_IF_TYPE_SNIFF && !reg->mode.disable
+			&& !dut_spi.dma_active
+			&& (DUT_SPI_RX_DMA_INST->CCR & DMA_CCR_EN)) {
+		return EBUSY;
+	}
+	if (reg->mode.if_type > SPI_IF_TYPE_SNIFF) {
+		return EINVAL;
+	}
+	/* The dma mode only handles a single address byte */
+	if (reg->mode.if_type == SPI_IF_TYPE_DMA && reg->mode.reg_16_bit) {
+		return EINVAL;
+	}
 	__HAL_SPI_DISABLE_IT(hspi, SPI_IT_RXNE | SPI_CR2_ERRIE | SPI_CR2_TXEIE);
+	_stop_dma();
+	_deinit_periph_spi_ic(htmr);
 
 	hspi->Init.CLKPhase = SPI_PHASE_1EDGE;
 	if (reg->mode.cpha) {
@@ -287,7 +491,32 @@ error_t commit_dut_spi() {
 	dut_spi.initial_byte = SPI_NO_DATA_BYTE;
 	memset(dut_spi.reg->sm_buf, 0, sizeof(dut_spi.reg->sm_buf));
 	memset(dut_spi.buf, 0, sizeof(dut_spi.buf));
-	dut_spi.poll_index = 0;
+	dut_spi.half_pos = 0;
+	dut_spi.rd_pos = 0;
+	dut_spi.frame_pos = 0;
+	_start_sm_frame();
+	dut_spi.frame_wr = 0;
+	dut_spi.frame_rd = 0;
+	dut_spi.has_prev = 0;
+	reg->sm_edges = 0;
+	reg->sm_lost = 0;
+	reg->sm_frames = 0;
+	reg->sm_bit_count = 0;
+	reg->sm_bit_min = MM_DEFAULT_PHILIP_MAP_SPI_SM_BIT_MIN;
+	reg->sm_bit_max = 0;
+	reg->sm_bit_sum = 0;
+	reg->sm_dead_count = 0;
+	reg->sm_dead_min = MM_DEFAULT_PHILIP_MAP_SPI_SM_DEAD_MIN;
+	reg->sm_dead_max = 0;
+	reg->sm_dead_sum = 0;
+	dut_spi.mosi_pos = 0;
+	dut_spi.bit_pos = 0;
+	dut_spi.bit_valid = 0;
+	dut_spi.sniff_rd = 0;
+	dut_spi.sniff_level = 0;
+	dut_spi.sniff_ack = 0;
+	reg->sniff_frames = 0;
+	reg->sniff_lost = 0;
 
 	if (reg->mode.if_type == SPI_IF_TYPE_REG) {
 		dut_spi.if_mode_int = _spi_reg_int;
@@ -298,6 +527,10 @@ error_t commit_dut_spi() {
 	} else if (reg->mode.if_type == SPI_IF_TYPE_SM) {
 		dut_spi.if_mode_int = NULL;
 		dut_spi.sm_active = 1;
+	} else if (reg->mode.if_type == SPI_IF_TYPE_DMA) {
+		dut_spi.if_mode_int = _spi_dma_int;
+	} else if (reg->mode.if_type == SPI_IF_TYPE_SNIFF) {
+		dut_spi.if_mode_int = NULL;
 	} else {
 		read_reg(0, &(dut_spi.initial_byte));
 		dut_spi.if_mode_int = _spi_const_int;
@@ -320,16 +553,39 @@ error_t commit_dut_spi() {
 			if (HAL_TIM_IC_ConfigChannel(htmr, ctmr_ic, DUT_SPI_IC_CHANNEL) != HAL_OK) {
 				_Error_Handler(__FILE__, __LINE__);
 			}
-			if (HAL_TIM_IC_Start_DMA(htmr, DUT_SPI_IC_CHANNEL, (uint32_t*)dut_spi.buf, sizeof(dut_spi.buf)/sizeof(dut_spi.buf[0])) != HAL_OK) {
+			if (HAL_TIM_IC_Start_DMA(htmr, DUT_SPI_IC_CHANNEL, (uint32_t*)dut_spi.buf, SPI_IC_BUF_SIZE) != HAL_OK) {
 				_Error_Handler(__FILE__, __LINE__);
 			}
+			/* The spi deinit released NSS, it marks the frame ends */
+			_init_gpio();
+		}
+		else if (reg->mode.if_type == SPI_IF_TYPE_SNIFF) {
+			hspi->Init.Direction = SPI_DIRECTION_2LINES_RXONLY;
+			HAL_SPI_Init(hspi);
+			hspi->Init.Direction = SPI_DIRECTION_2LINES;
+			__HAL_SPI_ENABLE(hspi);
+			/* The sampling edge is the first edge in phase 1 */
+			if ((hspi->Init.CLKPolarity == SPI_POLARITY_LOW)
+					== (hspi->Init.CLKPhase == SPI_PHASE_1EDGE)) {
+				_start_sniff(TIM_INPUTCHANNELPOLARITY_RISING);
+			}
+			else {
+				_start_sniff(TIM_INPUTCHANNELPOLARITY_FALLING);
+			}
 		}
 		else {
 			_deinit_periph_spi_ic(htmr);
 			HAL_SPI_Init(hspi);
 			__HAL_SPI_ENABLE(hspi);
 			hspi->Instance->DR = dut_spi.initial_byte;
-			__HAL_SPI_ENABLE_IT(hspi, SPI_IT_RXNE | SPI_CR2_ERRIE | SPI_CR2_TXEIE);
+			if (reg->mode.if_type == SPI_IF_TYPE_DMA) {
+				/* Only the address byte is handled by the cpu */
+				_start_dma();
+				__HAL_SPI_ENABLE_IT(hspi, SPI_IT_RXNE);
+			}
+			else {
+				__HAL_SPI_ENABLE_IT(hspi, SPI_IT_RXNE | SPI_CR2_ERRIE | SPI_CR2_TXEIE);
+			}
 		}
 	}
 	else {
@@ -370,12 +626,34 @@ void update_dut_spi_inputs() {
  */
 void DUT_SPI_INT(void) {
 	dut_spi.if_mode_int();
+	REG_SNAP_CHANGED(REG_SNAP_SPI);
+}
+
+/**
+ * @brief Restarts the dma of a read frame at the start of the map.
+ *
+ * The next byte is requested one spi byte after the last one so this must be
+ * served within a byte time.
+ */
+void DUT_SPI_TX_DMA_INT(void) {
+	if (!(dut_spi.dma_active && (DUT_SPI_TX_DMA_INST->CCR & DMA_CCR_TCIE))) {
+#ifdef DUT_SPI_TX_DMA_SHARED
+		DUT_UART_DMA_RX_INT();
+#endif
+		return;
+	}
+	DMA1->IFCR = DUT_SPI_TX_DMA_FLAGS;
+	DUT_SPI_TX_DMA_INST->CCR &= ~DMA_CCR_EN;
+	DUT_SPI_TX_DMA_INST->CMAR = (uint32_t)dut_spi.map_data;
+	DUT_SPI_TX_DMA_INST->CNDTR = sizeof(map_t);
+	DUT_SPI_TX_DMA_INST->CCR |= DMA_CCR_EN;
 }
 
 /******************************************************************************/
 static void _spi_reg_int() {
 	SPI_HandleTypeDef *hspi = &(dut_spi.hspi);
 	spi_t *spi = dut_spi.reg;
+	PROF_START(PROF_SPI_REG_INT);
 
 	if (spi->state == SPI_FRAME_STARTED) {
 		if (hspi->Instance->SR & SPI_FLAG_RXNE) {
@@ -411,6 +689,96 @@ static void _spi_reg_int() {
 			spi->transfer_count++;
 		}
 	}
+	PROF_END(PROF_SPI_REG_INT);
+}
+
+/* Only the address byte interrupts, the rest of the frame is streamed */
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+static void _spi_dma_int() {
+	SPI_TypeDef *inst = dut_spi.hspi.Instance;
+	spi_t *spi = dut_spi.reg;
+	uint32_t data;
+	uint16_t index;
+	uint16_t next;
+
+	if (!(inst->SR & SPI_FLAG_RXNE)) {
+		return;
+	}
+	data = inst->DR;
+	index = data & (~SPI_ADDR_MASK);
+	unprotected_read_uint8(index, (uint8_t*) &(inst->DR));
+
+	/* The first byte is already loaded so the dma continues after it, the
+	 * transfer complete restarts it at the start of the map */
+	DUT_SPI_TX_DMA_INST->CCR &= ~DMA_CCR_EN;
+	next = index;
+	add_index(&next);
+	DUT_SPI_TX_DMA_INST->CMAR = (uint32_t)&(dut_spi.map_data[next]);
+	DUT_SPI_TX_DMA_INST->CNDTR = sizeof(map_t) - next;
+	DMA1->IFCR = DUT_SPI_TX_DMA_FLAGS;
+	DUT_SPI_TX_DMA_INST->CCR |= DMA_CCR_TCIE | DMA_CCR_EN;
+	inst->CR2 = (inst->CR2 & ~SPI_CR2_RXNEIE)
+			| SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+
+	if (data & SPI_ADDR_MASK) {
+		spi->state = SPI_READING;
+	} else {
+		spi->state = SPI_WRITING;
+	}
+	spi->start_reg_index = index;
+	spi->reg_index = index;
+	spi->transfer_count++;
+}
+#pragma GCC pop_options
+
+/* Applies the frame the dma transferred, the access of the writes is checked
+ * and the counters are updated once per frame instead of per byte */
+static void _finish_dma_frame() {
+	spi_t *spi = dut_spi.reg;
+	uint16_t size;
+
+	CLEAR_BIT(dut_spi.hspi.Instance->CR2, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+	DUT_SPI_RX_DMA_INST->CCR &= ~DMA_CCR_EN;
+	size = SPI_DMA_BUF_SIZE - DUT_SPI_RX_DMA_INST->CNDTR;
+	DUT_SPI_RX_DMA_INST->CNDTR = SPI_DMA_BUF_SIZE;
+	DUT_SPI_RX_DMA_INST->CCR |= DMA_CCR_EN;
+	/* The dma already loaded the byte after the frame, the channel is
+	 * stopped so the DR reload of the caller is not overwritten */
+	DUT_SPI_TX_DMA_INST->CCR &= ~(DMA_CCR_TCIE | DMA_CCR_EN);
+	DUT_SPI_TX_DMA_INST->CMAR = (uint32_t)dut_spi.map_data;
+	DUT_SPI_TX_DMA_INST->CNDTR = 1;
+	DUT_SPI_TX_DMA_INST->CCR |= DMA_CCR_EN;
+	/* A full buffer with another byte waiting means the frame was longer,
+	 * the rest of it is lost */
+	if (size == SPI_DMA_BUF_SIZE
+			&& (dut_spi.hspi.Instance->SR & (SPI_SR_RXNE | SPI_SR_OVR))) {
+		spi->status.ovr = 1;
+		if (spi->state == SPI_WRITING) {
+			spi->status.index_err = 1;
+		}
+	}
+
+	if (spi->state == SPI_WRITING && size) {
+		if (write_regs(spi->start_reg_index, dut_spi.rx_buf, size,
+				MM_ACCESS_PERIPHERAL)) {
+			/* Protected bytes or a wrap, write what is allowed */
+			uint16_t index = spi->start_reg_index;
+			for (uint16_t i = 0; i < size; i++) {
+				if (write_reg(index, dut_spi.rx_buf[i],
+						MM_ACCESS_PERIPHERAL)) {
+					spi->status.index_err = 1;
+				}
+				add_index(&index);
+			}
+		}
+		spi->w_count += size;
+	} else if (spi->state == SPI_READING) {
+		spi->r_count += size;
+	}
+	spi->reg_index = (spi->start_reg_index + size) % sizeof(map_t);
+	spi->transfer_count += size;
+	__HAL_SPI_ENABLE_IT(&(dut_spi.hspi), SPI_IT_RXNE);
 }
 
 static void _spi_hs_int() {
@@ -462,6 +830,24 @@ static void _spi_const_int() {
 #pragma GCC push_options
 #pragma GCC optimize ("O3")
 void GPIO_NSS_INT() {
+	if (dut_spi.sm_active) {
+		if (HAL_GPIO_ReadPin(DUT_NSS)) {
+			_latch_frame_end();
+			REG_SNAP_CHANGED(REG_SNAP_SPI);
+		}
+		return;
+	}
+	if (dut_spi.sniff_active) {
+		if (HAL_GPIO_ReadPin(DUT_NSS)) {
+			_latch_sniff_frame();
+		}
+		else {
+			dut_spi.sniff_tick = get_tick();
+			dut_spi.sniff_edge = _get_ic_position();
+		}
+		REG_SNAP_CHANGED(REG_SNAP_SPI);
+		return;
+	}
 	if (HAL_GPIO_ReadPin(DUT_NSS)) {
 		/* Finished frame */
 		uint32_t itflag = dut_spi.hspi.Instance->SR;
@@ -484,12 +870,17 @@ void GPIO_NSS_INT() {
 			dut_spi.reg->status.udr = 1;
 		}
 
+		if (dut_spi.dma_active) {
+			_finish_dma_frame();
+		}
+
 		/* clear status and errors */
 		uint32_t tmp = dut_spi.hspi.Instance->DR;
 		(void) tmp;
 		dut_spi.hspi.Instance->DR = dut_spi.initial_byte;
 
 		dut_spi.reg->state = SPI_FRAME_FINISHED;
+		REG_SNAP_CHANGED(REG_SNAP_SPI);
 	} else {
 		/* Starting frame */
 		if (dut_spi.reg->mode.if_type == SPI_IF_TYPE_CONST) {
@@ -500,16 +891,19 @@ void GPIO_NSS_INT() {
 				(void)dut_spi.hspi.Instance->DR;
 				dut_spi.reg->transfer_count = 1;
 			}
+			REG_SNAP_CHANGED(REG_SNAP_SPI);
 			return;
 		}
 		dut_spi.reg->status.start_clk = HAL_GPIO_ReadPin(DUT_SCK);
 		dut_spi.hspi.Instance->DR = dut_spi.initial_byte;
 		dut_spi.reg->transfer_count = 0;
 		if (dut_spi.reg->mode.if_type == SPI_IF_TYPE_ECHO) {
+			REG_SNAP_CHANGED(REG_SNAP_SPI);
 			return;
 		}
 		dut_spi.reg->reg_index = 0;
 		dut_spi.reg->state = SPI_FRAME_STARTED;
+		REG_SNAP_CHANGED(REG_SNAP_SPI);
 	}
 }
 #pragma GCC pop_options
@@ -518,13 +912,185 @@ void GPIO_NSS_INT() {
 /*           Clock speed measurement                                          */
 /******************************************************************************/
 void poll_dut_spi_ic(){
+	PROF_START(PROF_POLL_DUT_SPI_IC);
 	if (dut_spi.sm_active){
-		uint16_t current_index = sizeof(dut_spi.buf)/sizeof(dut_spi.buf[0]) - TIMER_REMAINING_BUF(dut_spi.htmr_dma);
-		while (dut_spi.poll_index < current_index){
-			dut_spi.reg->sm_buf[dut_spi.poll_index] = dut_spi.buf[dut_spi.poll_index];
-			dut_spi.poll_index++;
-			dut_spi.reg->transfer_count = (int)(dut_spi.poll_index);
+		_measure_edges(_get_ic_position());
+	}
+	PROF_END(PROF_POLL_DUT_SPI_IC);
+}
+
+uint8_t get_dut_spi_ic_fill() {
+	uint32_t waiting;
+
+	if (!dut_spi.sm_active) {
+		return 0;
+	}
+	waiting = _get_ic_position() - dut_spi.rd_pos;
+	if (waiting > SPI_IC_BUF_SIZE) {
+		return 100;
+	}
+	return waiting * 100 / SPI_IC_BUF_SIZE;
+}
+
+/* Absolute position the next edge is written to, the filled halves may be one
+ * half behind if the dma interrupt is pending */
+static uint32_t _get_ic_position() {
+	uint32_t half;
+	uint32_t index;
+
+	DIS_INT;
+	half = dut_spi.half_pos;
+	index = SPI_IC_BUF_SIZE - TIMER_REMAINING_BUF(dut_spi.htmr_dma);
+	EN_INT;
+	return half + ((index - half) & (SPI_IC_BUF_SIZE - 1));
+}
+
+/* The edge after a frame end starts a new byte and the gap to it is not a
+ * deadtime, if the poll is far behind the newest end is moved */
+static void _latch_frame_end() {
+	uint8_t wr = dut_spi.frame_wr;
+	uint8_t next = (wr + 1) & (SPI_IC_FRAME_SIZE - 1);
+
+	if (next == dut_spi.frame_rd) {
+		wr = (wr - 1) & (SPI_IC_FRAME_SIZE - 1);
+		next = dut_spi.frame_wr;
+	}
+	dut_spi.frame_end[wr] = _get_ic_position();
+	dut_spi.frame_wr = next;
+	dut_spi.reg->sm_frames++;
+}
+
+/* Keeps the newest half of the buffer, the bytes stay aligned since the
+ * absolute position is known */
+static void _skip_lost(uint32_t pos) {
+	uint32_t lost = pos - SPI_IC_BUF_SIZE / 2 - dut_spi.rd_pos;
+
+	dut_spi.reg->sm_lost += lost;
+	dut_spi.rd_pos += lost;
+	dut_spi.has_prev = 0;
+}
+
+/* Sorts the differences of the captured edges into bit periods and deadtimes,
+ * every eighth edge of a frame starts a byte */
+static void _measure_edges(uint32_t pos) {
+	spi_t *reg = dut_spi.reg;
+
+	if (pos - dut_spi.rd_pos > SPI_IC_BUF_SIZE) {
+		_skip_lost(pos);
+	}
+	while (dut_spi.rd_pos != pos) {
+		uint32_t n = dut_spi.rd_pos;
+		uint16_t val = dut_spi.buf[n & (SPI_IC_BUF_SIZE - 1)];
+		/* The capture keeps running, check the value was not overwritten */
+		uint32_t now = _get_ic_position();
+
+		if (now - n > SPI_IC_BUF_SIZE) {
+			_skip_lost(now);
+			pos = now;
+			continue;
+		}
+		if (n < sizeof(reg->sm_buf) / sizeof(reg->sm_buf[0])) {
+			reg->sm_buf[n] = val;
+			reg->transfer_count = n + 1;
+		}
+		while (dut_spi.frame_rd != dut_spi.frame_wr
+				&& (int32_t)(dut_spi.frame_end[dut_spi.frame_rd] - n) <= 0) {
+			dut_spi.frame_pos = dut_spi.frame_end[dut_spi.frame_rd];
+			dut_spi.has_prev = 0;
+			dut_spi.frame_rd = (dut_spi.frame_rd + 1) & (SPI_IC_FRAME_SIZE - 1);
+			_start_sm_frame();
 		}
+		if ((n - dut_spi.frame_pos) % BITS_PER_BYTE == 0) {
+			dut_spi.byte_sum = 0;
+			dut_spi.byte_bits = 0;
+		}
+		if (dut_spi.has_prev) {
+			uint16_t diff = val - dut_spi.prev_val;
+
+			dut_spi.frame_ticks += diff;
+			dut_spi.frame_edges++;
+			if ((n - dut_spi.frame_pos) % BITS_PER_BYTE) {
+				_add_bit(n, diff);
+			}
+			else {
+				uint16_t dead = 0;
+
+				if (diff > dut_spi.prev_bit) {
+					dead = diff - dut_spi.prev_bit;
+				}
+				if (reg->sm_dead_min > dead) {
+					reg->sm_dead_min = dead;
+				}
+				if (reg->sm_dead_max < dead) {
+					reg->sm_dead_max = dead;
+				}
+				reg->sm_dead_sum += dead;
+				reg->sm_dead_count++;
+			}
+		}
+		dut_spi.prev_val = val;
+		dut_spi.has_prev = 1;
+		dut_spi.rd_pos++;
+	}
+	reg->sm_edges = dut_spi.rd_pos;
+	if (dut_spi.frame_bit_sum) {
+		reg->sm_frame_freq = (uint64_t)SystemCoreClock * dut_spi.frame_bits
+				/ dut_spi.frame_bit_sum;
+	}
+	if (dut_spi.frame_ticks) {
+		reg->sm_frame_rate = (uint64_t)SystemCoreClock * dut_spi.frame_edges
+				/ dut_spi.frame_ticks;
+	}
+}
+
+/* The frame values describe the current frame until the next one starts */
+static void _start_sm_frame() {
+	spi_t *reg = dut_spi.reg;
+
+	dut_spi.frame_bit_sum = 0;
+	dut_spi.frame_bits = 0;
+	dut_spi.frame_ticks = 0;
+	dut_spi.frame_edges = 0;
+	reg->sm_frame_bytes = 0;
+	reg->sm_frame_freq = 0;
+	reg->sm_frame_rate = 0;
+	memset(reg->sm_byte_freq, 0, sizeof(reg->sm_byte_freq));
+}
+
+/* Adds a bit period to the totals and the frame, the last bit of a byte
+ * completes its mean frequency */
+static void _add_bit(uint32_t n, uint16_t diff) {
+	spi_t *reg = dut_spi.reg;
+	uint32_t byte = (n - dut_spi.frame_pos) / BITS_PER_BYTE;
+
+	if (reg->sm_bit_min > diff) {
+		reg->sm_bit_min = diff;
+	}
+	if (reg->sm_bit_max < diff) {
+		reg->sm_bit_max = diff;
+	}
+	reg->sm_bit_sum += diff;
+	reg->sm_bit_count++;
+	dut_spi.prev_bit = diff;
+	dut_spi.frame_bit_sum += diff;
+	dut_spi.frame_bits++;
+	dut_spi.byte_sum += diff;
+	dut_spi.byte_bits++;
+	if ((n - dut_spi.frame_pos) % BITS_PER_BYTE != BITS_PER_BYTE - 1) {
+		return;
+	}
+	reg->sm_frame_bytes = byte + 1;
+	if (byte < sizeof(reg->sm_byte_freq) / sizeof(reg->sm_byte_freq[0])
+			&& dut_spi.byte_sum) {
+		reg->sm_byte_freq[byte] = SystemCoreClock * dut_spi.byte_bits
+				/ dut_spi.byte_sum;
+	}
+}
+
+void dut_spi_ic_half_cplt() {
+	dut_spi.half_pos += SPI_IC_BUF_SIZE / 2;
+	if (dut_spi.sniff_active) {
+		_pack_miso(dut_spi.half_pos);
 	}
 }
 
@@ -534,3 +1100,178 @@ void poll_dut_spi_ic(){
 void DUT_SPI_IC_DMA_INT(void) {
 	HAL_DMA_IRQHandler(&dut_spi.htmr_dma);
 }
+
+/******************************************************************************/
+/*           Sniffer                                                          */
+/******************************************************************************/
+/* Packs the MISO samples up to the position as bits, samples that were
+ * already overwritten by the capture are skipped */
+static void _pack_miso(uint32_t pos) {
+	if ((int32_t)(pos - dut_spi.bit_pos) <= 0) {
+		return;
+	}
+	if (pos - dut_spi.bit_pos >= SPI_IC_BUF_SIZE) {
+		dut_spi.bit_pos = pos - SPI_IC_BUF_SIZE / 2;
+		dut_spi.bit_valid = dut_spi.bit_pos;
+	}
+	while (dut_spi.bit_pos != pos) {
+		uint32_t n = dut_spi.bit_pos;
+		uint8_t *bits = &dut_spi.miso_bits[(n / BITS_PER_BYTE)
+				& (SPI_SNIFF_BITS_SIZE - 1)];
+		uint8_t mask = 0x80 >> (n % BITS_PER_BYTE);
+
+		if (dut_spi.buf[n & (SPI_IC_BUF_SIZE - 1)] & DUT_MISO_Pin) {
+			*bits |= mask;
+		}
+		else {
+			*bits &= ~mask;
+		}
+		dut_spi.bit_pos++;
+	}
+}
+
+/* The MOSI dma only moves during frames of the sniffed device so its position
+ * gives the size, the MISO samples of the frame are the last ones captured */
+static void _latch_sniff_frame() {
+	spi_t *reg = dut_spi.reg;
+	uint32_t edge = _get_ic_position();
+	uint16_t index = SPI_DMA_BUF_SIZE - DUT_SPI_RX_DMA_INST->CNDTR;
+	uint16_t size = (index - dut_spi.mosi_pos) & (SPI_DMA_BUF_SIZE - 1);
+	uint16_t flags = 0;
+	uint64_t tick = get_tick();
+
+	DIS_INT;
+	_pack_miso(edge);
+	EN_INT;
+	if (edge - dut_spi.sniff_edge >= SPI_DMA_BUF_SIZE * BITS_PER_BYTE) {
+		flags = SPI_SNIFF_FLAG_OVERFLOW;
+	}
+	reg->frame_ticks = (uint32_t)(tick - dut_spi.sniff_tick);
+	reg->transfer_count = size;
+	reg->sniff_frames++;
+	if (dut_spi.sniff_level >= SPI_SNIFF_FRAME_SIZE) {
+		reg->sniff_lost++;
+	}
+	else {
+		spi_sniff_frame_t *frame = &dut_spi.sniff[(dut_spi.sniff_rd
+				+ dut_spi.sniff_level) % SPI_SNIFF_FRAME_SIZE];
+
+		frame->tick = dut_spi.sniff_tick;
+		frame->duration = reg->frame_ticks;
+		frame->mosi_pos = dut_spi.mosi_pos;
+		frame->bit_pos = edge - size * BITS_PER_BYTE;
+		frame->size = size;
+		frame->flags = flags;
+		dut_spi.sniff_level++;
+	}
+	/* A frame that wrapped the ring overwrote all older bytes */
+	dut_spi.mosi_pos += size;
+	if (flags & SPI_SNIFF_FLAG_OVERFLOW) {
+		dut_spi.mosi_pos += SPI_DMA_BUF_SIZE;
+	}
+}
+
+error_t drain_dut_spi_sniff(uint16_t ack, uint8_t *buf, uint16_t max_size,
+		uint16_t *size, uint16_t *pos, uint16_t *pending) {
+	uint16_t discard;
+	uint16_t index;
+	uint16_t count;
+
+	DIS_INT;
+	discard = ack - dut_spi.sniff_ack;
+	if (discard > dut_spi.sniff_level) {
+		EN_INT;
+		return ERANGE;
+	}
+	dut_spi.sniff_rd = (dut_spi.sniff_rd + discard) % SPI_SNIFF_FRAME_SIZE;
+	dut_spi.sniff_level -= discard;
+	dut_spi.sniff_ack = ack;
+	index = dut_spi.sniff_rd;
+	count = dut_spi.sniff_level;
+	EN_INT;
+
+	*pos = ack;
+	*pending = count;
+	*size = 0;
+	/* Only free slots are written by the interrupts so no need to lock */
+	for (uint16_t i = 0; i < count; i++) {
+		uint16_t packed = _pack_sniff_frame(&buf[*size], max_size - *size,
+				&dut_spi.sniff[index], i == 0);
+
+		if (packed == 0) {
+			break;
+		}
+		*size += packed;
+		if (++index >= SPI_SNIFF_FRAME_SIZE) {
+			index = 0;
+		}
+	}
+	return 0;
+}
+
+/* Packs the header, the MOSI bytes and the MISO bytes, the data is checked
+ * after copying since the dma keeps writing, only the first frame is cut to
+ * fit */
+static uint16_t _pack_sniff_frame(uint8_t *buf, uint16_t max_size,
+		const spi_sniff_frame_t *frame, uint8_t first) {
+	uint8_t *mosi = &buf[SPI_SNIFF_HDR_SIZE];
+	uint16_t flags = frame->flags;
+	uint16_t len = frame->size;
+	uint32_t mosi_end;
+	uint32_t bit_pos;
+	uint32_t bit_valid;
+
+	if (flags & SPI_SNIFF_FLAG_OVERFLOW) {
+		len = 0;
+	}
+	if (max_size < SPI_SNIFF_HDR_SIZE) {
+		return 0;
+	}
+	if (SPI_SNIFF_HDR_SIZE + 2 * len > max_size) {
+		if (!first) {
+			return 0;
+		}
+		len = (max_size - SPI_SNIFF_HDR_SIZE) / 2;
+		flags |= SPI_SNIFF_FLAG_CUT;
+	}
+	for (uint16_t i = 0; i < len; i++) {
+		uint32_t bit = frame->bit_pos + i * BITS_PER_BYTE;
+		uint8_t shift = bit % BITS_PER_BYTE;
+		uint16_t byte = (bit / BITS_PER_BYTE) & (SPI_SNIFF_BITS_SIZE - 1);
+		uint16_t next = (byte + 1) & (SPI_SNIFF_BITS_SIZE - 1);
+
+		mosi[i] = dut_spi.rx_buf[(frame->mosi_pos + i)
+				& (SPI_DMA_BUF_SIZE - 1)];
+		mosi[len + i] = (uint8_t)((dut_spi.miso_bits[byte] << shift)
+				| ((uint16_t)dut_spi.miso_bits[next] >> (8 - shift)));
+	}
+
+	DIS_INT;
+	mosi_end = dut_spi.mosi_pos + ((SPI_DMA_BUF_SIZE
+			- DUT_SPI_RX_DMA_INST->CNDTR - dut_spi.mosi_pos)
+			& (SPI_DMA_BUF_SIZE - 1));
+	bit_pos = dut_spi.bit_pos;
+	bit_valid = dut_spi.bit_valid;
+	EN_INT;
+	if (mosi_end - frame->mosi_pos > SPI_DMA_BUF_SIZE) {
+		flags |= SPI_SNIFF_FLAG_MOSI_LOST;
+	}
+	if (bit_pos - frame->bit_pos > SPI_SNIFF_BITS_SIZE * BITS_PER_BYTE
+			|| (int32_t)(frame->bit_pos - bit_valid) < 0) {
+		flags |= SPI_SNIFF_FLAG_MISO_LOST;
+	}
+
+	for (uint8_t i = 0; i < 8; i++) {
+		buf[i] = (uint8_t)(frame->tick >> (8 * i));
+	}
+	for (uint8_t i = 0; i < 4; i++) {
+		buf[8 + i] = (uint8_t)(frame->duration >> (8 * i));
+	}
+	buf[12] = (uint8_t)frame->size;
+	buf[13] = (uint8_t)(frame->size >> 8);
+	buf[14] = (uint8_t)len;
+	buf[15] = (uint8_t)(len >> 8);
+	buf[16] = (uint8_t)flags;
+	buf[17] = (uint8_t)(flags >> 8);
+	return SPI_SNIFF_HDR_SIZE + 2 * len;
+}
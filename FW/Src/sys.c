@@ -32,6 +32,7 @@
 #include "app_common.h"
 #include "app_defaults.h"
 #include "port.h"
+#include "uart.h"
 
 #include "sys.h"
 
@@ -93,7 +94,7 @@ error_t commit_sys() {
 	}
 	sys_inst->mode.init = 1;
 
-	return 0;
+	return set_if_uart_baud(sys_inst->if_baud);
 }
 
 /******************************************************************************/
@@ -21,8 +21,24 @@
  * can still be caught up to 200ns. However the buffer still must not overflow
  * too quickly
  *
- * @note  Testing shows the a 150us wait must happen for every 255 events to
- * prevent any data corruption.
+ * The half and complete interrupts of the capture DMA count the filled halves
+ * so the absolute position of every edge is known however late it is polled,
+ * edges overwritten before being read are reported as dropped.
+ *
+ * Timer overflows are latched by hardware, a compare in the middle of every
+ * period triggers a second DMA that copies the write position of the capture
+ * buffer. Edges after a mark with a value below the middle belong to the next
+ * period. Only an edge captured within the few ticks it takes to transfer the
+ * mark, with no other edge around it, can land in the wrong period.
+ *
+ * The differences between the drained edges are sorted into a histogram and
+ * summed for the mean and variance, so the jitter of a DUT clock can be read
+ * without transferring every edge.
+ *
+ * As a frequency counter the pin clocks the timer and the cascade timer counts
+ * its overflows, no edge needs the cpu. The poll ends each gate by reading the
+ * count together with the systick, alternate gates count the high time with
+ * the pin gating the timer for the duty cycle.
  * @}
  ******************************************************************************
  */
@@ -34,23 +50,72 @@
 
 #include "mm_typedefs.h"
 #include "mm_default_philip_map.h"
+#include "app_common.h"
 #include "port.h"
 #include "gpio.h"
+#include "app_reg.h"
 #include "trace.h"
+#include "prof.h"
 
 #include "tmr.h"
 
+/* Private defines ************************************************************/
+#define DUT_IC_BUF_SIZE		(256) /**< Edges in the capture buffer, power of 2 */
+#define DUT_IC_MARK_SIZE	(2) /**< Marks in the mark buffer, one interrupt each */
+#define DUT_IC_EPOCH_SIZE	(16) /**< Resolved marks waiting for the poll */
+#define DUT_IC_MARK_TICK	(0x8000) /**< Timer value that latches a mark */
+/** @brief	Ticks the lower cascade capture trails the upper one, it passes
+ * 			through the trigger synchronisation of both timers
+ *
+ * The halves are not latched by the same event so an edge within the skew
+ * of a lower half wrap may resolve to one upper count off. */
+#define DUT_IC_CASCADE_SKEW	(4)
+/** @brief	Longest read of the frequency counter in ticks, it is retried
+ * 			if interrupted */
+#define FREQ_READ_TICKS		(200)
+/** @brief	Amount of buckets in the histogram registers */
+#define NUM_OF_HIST_BUCKETS	(sizeof(((map_t*)0)->tmr.hist)/sizeof(((map_t*)0)->tmr.hist[0]))
+
 /* Private enums/structs ******************************************************/
+/** @brief					A resolved overflow mark */
+typedef struct {
+	uint32_t pos; /**< Absolute buffer position of the first edge after it */
+	uint32_t amount; /**< Overflows at that position */
+} tmr_epoch_t;
+
 /** @brief					The parameters for tmr control */
 typedef struct {
 	TIM_HandleTypeDef htmr; /**< Handle for the tmr device */
 	DMA_HandleTypeDef htmr_dma; /**< Handle for the tmr dma */
+	DMA_HandleTypeDef hmark_dma; /**< Handle for the overflow mark dma */
+	TIM_HandleTypeDef hcas; /**< Handle for the lower 16 bits of the cascade */
+	DMA_HandleTypeDef hcas_dma; /**< Handle for the cascade dma */
 	TIM_IC_InitTypeDef ctmr_ic; /**< Initialization for timer */
 	tmr_t *reg; /**< Timer related registers */
-	uint32_t of_tick; /**< The overflow tick counter */
-	uint16_t buf[256]; /**< Buffer for DMA or interrupt ticks */
-	uint8_t int_index; /**< Interrupt buffer index */
-	uint8_t poll_index; /**< Buffer index when polling */
+	uint64_t of_tick; /**< The overflow tick counter */
+	uint64_t last_tick; /**< Tick of the previous edge */
+	uint64_t cas_tick; /**< Tick of the cascade count read by the poll */
+	uint32_t cas_now; /**< Cascade count read by the poll */
+	uint32_t hist_start; /**< Lower bound of the first bucket */
+	uint32_t hist_width; /**< Tick differences per bucket, 0 for none */
+	uint8_t hist_numof; /**< Amount of buckets used */
+	uint8_t has_last; /**< The previous edge was not lost */
+	uint64_t gate_start; /**< Tick the current frequency gate started */
+	uint64_t gate_len; /**< Ticks of a frequency gate */
+	uint32_t gate_cnt; /**< Count when the current gate started */
+	uint8_t gate_duty; /**< The current gate measures the high time */
+	uint16_t buf[DUT_IC_BUF_SIZE]; /**< Buffer for DMA or interrupt ticks */
+	uint16_t cas_buf[DUT_IC_BUF_SIZE]; /**< Lower 16 bits of the cascade */
+	uint16_t mark[DUT_IC_MARK_SIZE]; /**< Buffer positions latched by marks */
+	tmr_epoch_t epoch[DUT_IC_EPOCH_SIZE]; /**< Marks resolved by the dma */
+	volatile uint32_t half_pos; /**< Absolute position of the filled halves */
+	volatile uint32_t int_pos; /**< Absolute position in interrupt mode */
+	uint32_t rd_pos; /**< Absolute position of the next edge to flush */
+	volatile uint8_t epoch_wr; /**< Epoch write index */
+	uint8_t epoch_rd; /**< Epoch read index */
+	uint8_t mark_rd; /**< Next mark to resolve */
+	uint8_t wrapped; /**< Edges since the last mark are after the overflow */
+	uint16_t prev_val; /**< Previous timer value since the last mark */
 	uint16_t initial_level; /**< When measuing both edges this is the initial value */
 	tmr_mode_t mode; /**< Internal timer mode settings */
 } tmr_dev_t;
@@ -60,8 +125,21 @@ static tmr_dev_t dut_ic = {0}; /**< DUT_IC device */
 
 /* Private function prototypes ************************************************/
 static void _init_periph_ic();
-static uint8_t _get_current_index();
-static void _flush_tmr_buf(uint8_t dma_index, uint32_t of_tick);
+static void _start_mark();
+static void _start_cascade();
+static void _update_cascade();
+static uint64_t _get_cascade_tick(uint16_t hi, uint16_t lo);
+static void _add_hist(uint32_t diff, uint16_t edge);
+static void _start_freq();
+static void _set_freq_phase(uint8_t duty);
+static uint32_t _read_freq_count();
+static void _read_freq_gate(uint64_t *tick, uint32_t *count);
+static void _poll_freq();
+static uint32_t _get_position();
+static void _resolve_marks(DMA_HandleTypeDef *hdma);
+static void _pass_marks();
+static void _skip_lost(uint32_t pos);
+static void _flush_tmr_buf(uint32_t pos);
 
 /******************************************************************************/
 /*           Initialization                                                   */
@@ -76,6 +154,7 @@ void init_dut_ic(map_t *map) {
 static void _init_periph_ic() {
 	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
 	TIM_IC_InitTypeDef* ctmr_ic = &(dut_ic.ctmr_ic);
+	TIM_HandleTypeDef *hcas = &(dut_ic.hcas);
 	TIM_ClockConfigTypeDef sClockSourceConfig = {0};
 	TIM_MasterConfigTypeDef sMasterConfig = {0};
 
@@ -108,14 +187,25 @@ static void _init_periph_ic() {
 	ctmr_ic->ICSelection = TIM_ICSELECTION_DIRECTTI;
 	ctmr_ic->ICPrescaler = TIM_ICPSC_DIV1;
 	ctmr_ic->ICFilter = 0;
+
+	hcas->Instance = DUT_IC_CASCADE_INST;
+	hcas->Init.Prescaler = 0;
+	hcas->Init.CounterMode = TIM_COUNTERMODE_UP;
+	hcas->Init.Period = 0xFFFF;
+	hcas->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	hcas->Init.RepetitionCounter = 0;
+	hcas->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
 }
 
 void init_dut_ic_msp() {
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
 	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
 	DMA_HandleTypeDef *htmr_dma = &(dut_ic.htmr_dma);
+	DMA_HandleTypeDef *hmark_dma = &(dut_ic.hmark_dma);
+	DMA_HandleTypeDef *hcas_dma = &(dut_ic.hcas_dma);
 	/* Peripheral clock enable */
 	DUT_IC_CLK_EN();
+	DUT_IC_CASCADE_CLK_EN();
 	DUT_IC_GPIO_CLK_EN();
 
 	GPIO_InitStruct.Pin = DUT_IC_Pin;
@@ -135,13 +225,34 @@ void init_dut_ic_msp() {
 	htmr_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
 	htmr_dma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
 	htmr_dma->Init.Mode = DMA_CIRCULAR;
-	htmr_dma->Init.Priority = DMA_PRIORITY_LOW;
+	/* Edges captured before a mark must be transferred before it */
+	htmr_dma->Init.Priority = DMA_PRIORITY_HIGH;
     if (HAL_DMA_Init(htmr_dma) != HAL_OK)
     {
     	_Error_Handler(__FILE__, __LINE__);
     }
 
     __HAL_LINKDMA(htmr,hdma[DUT_IC_DMA_ID],*htmr_dma);
+
+	hmark_dma->Instance = DUT_IC_MARK_DMA_INST;
+	hmark_dma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hmark_dma->Init.PeriphInc = DMA_PINC_DISABLE;
+	hmark_dma->Init.MemInc = DMA_MINC_ENABLE;
+	hmark_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	hmark_dma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hmark_dma->Init.Mode = DMA_CIRCULAR;
+	hmark_dma->Init.Priority = DMA_PRIORITY_LOW;
+
+	/* The channel may be shared with the marks, both are initialized when
+	 * they start */
+	hcas_dma->Instance = DUT_IC_CASCADE_DMA_INST;
+	hcas_dma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hcas_dma->Init.PeriphInc = DMA_PINC_DISABLE;
+	hcas_dma->Init.MemInc = DMA_MINC_ENABLE;
+	hcas_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	hcas_dma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hcas_dma->Init.Mode = DMA_CIRCULAR;
+	hcas_dma->Init.Priority = DMA_PRIORITY_HIGH;
     /* Priority must be high to ensure no jitter
      * Since the only data changing is the index and buffer and it is protected
      * we can use different priorities without worrying about */
@@ -149,15 +260,23 @@ void init_dut_ic_msp() {
     HAL_NVIC_EnableIRQ(DUT_IC_GPIO_IRQ);
     HAL_NVIC_SetPriority(DUT_IC_DMA_IRQ, DEFAULT_INT_PRIO, 0);
     HAL_NVIC_EnableIRQ(DUT_IC_DMA_IRQ);
+    /* Same priority as the capture dma so the filled halves cannot change
+     * while a mark is resolved */
+    HAL_NVIC_SetPriority(DUT_IC_MARK_DMA_IRQ, DEFAULT_INT_PRIO, 0);
+    HAL_NVIC_EnableIRQ(DUT_IC_MARK_DMA_IRQ);
 }
 
 void deinit_dut_ic_msp() {
 	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
 
 	DUT_IC_CLK_DIS();
+	DUT_IC_CASCADE_CLK_DIS();
 	HAL_GPIO_DeInit(DUT_IC);
 	HAL_DMA_DeInit(htmr->hdma[DUT_IC_DMA_ID]);
+	HAL_DMA_DeInit(&dut_ic.hmark_dma);
+	HAL_DMA_DeInit(&dut_ic.hcas_dma);
 
+    HAL_NVIC_DisableIRQ(DUT_IC_MARK_DMA_IRQ);
     HAL_NVIC_DisableIRQ(DUT_IC_DMA_IRQ);
     HAL_NVIC_DisableIRQ(DUT_IC_GPIO_IRQ);
 }
@@ -168,14 +287,54 @@ void deinit_dut_ic_msp() {
 error_t commit_dut_ic() {
 	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
 	TIM_IC_InitTypeDef* ctmr_ic = &(dut_ic.ctmr_ic);
+	TIM_SlaveConfigTypeDef sSlaveConfig = {0};
+	TIM_MasterConfigTypeDef sMasterConfig = {0};
 	tmr_t *reg = dut_ic.reg;
 
 	if (reg->mode.init) {
 		return 0;
 	}
+	/* The channel is only free if it is enabled by the own capture dma, a
+	 * busy commit stays pending so it can be retried */
+	if (!reg->mode.disable && !reg->mode.freq
+			&& reg->mode.trig_edge != DUT_IC_EDGE_BOTH
+			&& (DUT_IC_DMA_INST->CCR & DMA_CCR_EN)
+			&& htmr->hdma[DUT_IC_DMA_ID]->State != HAL_DMA_STATE_BUSY) {
+		return -EBUSY;
+	}
 	reg->mode.init = 1;
 
+	/* A rejected setting must leave the running capture untouched */
+	if (!reg->mode.disable) {
+		if (reg->mode.cascade && reg->mode.trig_edge == DUT_IC_EDGE_BOTH) {
+			return -EINVAL;
+		}
+		if (reg->hist_numof > NUM_OF_HIST_BUCKETS) {
+			return -EINVAL;
+		}
+		if (reg->mode.freq && (reg->mode.cascade || reg->gate_ms == 0)) {
+			return -EINVAL;
+		}
+	}
+
 	HAL_TIM_IC_Stop_DMA(htmr, DUT_IC_CHANNEL);
+	HAL_DMA_Abort(&dut_ic.hmark_dma);
+	__HAL_TIM_DISABLE_DMA(htmr, DUT_IC_MARK_DMA_SRC);
+	HAL_TIM_IC_Stop(&dut_ic.hcas, TIM_CHANNEL_1);
+	HAL_DMA_Abort(&dut_ic.hcas_dma);
+	__HAL_TIM_DISABLE_DMA(&dut_ic.hcas, TIM_DMA_CC1);
+	HAL_TIM_Base_Stop(&dut_ic.hcas);
+	dut_ic.mode.freq = 0;
+	sSlaveConfig.SlaveMode = TIM_SLAVEMODE_DISABLE;
+	sSlaveConfig.InputTrigger = DUT_IC_CASCADE_ITR;
+	if (HAL_TIM_SlaveConfigSynchro(htmr, &sSlaveConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+	sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+	if (HAL_TIMEx_MasterConfigSynchronization(htmr, &sMasterConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
 	dut_ic.mode.disable = reg->mode.disable;
 	if (dut_ic.reg->mode.disable) {
 		if (HAL_TIM_Base_DeInit(htmr) != HAL_OK) {
@@ -190,16 +349,54 @@ error_t commit_dut_ic() {
 	if (HAL_TIM_Base_Init(htmr) != HAL_OK) {
 		_Error_Handler(__FILE__, __LINE__);
 	}
+	if (reg->mode.freq) {
+		dut_ic.mode.trig_edge = reg->mode.trig_edge;
+		reg->gate_count = 0;
+		reg->gate_tick = 0;
+		reg->edge_count = 0;
+		reg->freq = 0;
+		reg->duty = 0;
+		HAL_NVIC_DisableIRQ(DUT_IC_GPIO_IRQ);
+		_start_freq();
+		dut_ic.mode.freq = 1;
+		return 0;
+	}
 
-	dut_ic.poll_index = 0;
-	dut_ic.int_index = 0;
+	dut_ic.half_pos = 0;
+	dut_ic.int_pos = 0;
+	dut_ic.rd_pos = 0;
+	dut_ic.epoch_wr = 0;
+	dut_ic.epoch_rd = 0;
+	dut_ic.mark_rd = 0;
+	/* The counter starts at 0 so the edges before the first mark are already
+	 * in the period of that mark */
 	dut_ic.of_tick = 0;
+	dut_ic.wrapped = 1;
+	dut_ic.last_tick = 0;
+	dut_ic.cas_tick = 0;
+	dut_ic.cas_now = 0;
 	dut_ic.mode.trig_edge = reg->mode.trig_edge;
+	dut_ic.mode.cascade = reg->mode.cascade;
+	dut_ic.mode.hist_pulse = reg->mode.hist_pulse;
+	dut_ic.has_last = 0;
+	dut_ic.hist_start = reg->hist_start;
+	dut_ic.hist_width = reg->hist_width;
+	dut_ic.hist_numof = reg->hist_numof;
 	reg->max_tick = 0;
 	reg->min_tick = MM_DEFAULT_PHILIP_MAP_TMR_MIN_TICK;
+	reg->hist_below = 0;
+	reg->hist_above = 0;
+	for (uint8_t i = 0; i < NUM_OF_HIST_BUCKETS; i++) {
+		reg->hist[i] = 0;
+	}
+	reg->stat_count = 0;
+	reg->stat_ref = 0;
+	reg->stat_sum = 0;
+	reg->stat_sum_sq = 0;
 	reg->min_holdoff = DMA_HOLDOFF_NS;
 	if (reg->mode.trig_edge == DUT_IC_EDGE_BOTH) {
 		reg->min_holdoff = INT_HOLDOFF_NS;
+		_start_mark();
 		if (HAL_TIM_Base_Start(htmr) != HAL_OK) {
 			_Error_Handler(__FILE__, __LINE__);
 		}
@@ -222,65 +419,441 @@ error_t commit_dut_ic() {
 		_Error_Handler(__FILE__, __LINE__);
 	}
 
-	if (HAL_TIM_IC_Start_DMA(htmr, DUT_IC_CHANNEL, (uint32_t*)dut_ic.buf, sizeof(dut_ic.buf)/sizeof(dut_ic.buf[0])) != HAL_OK) {
+	if (dut_ic.mode.cascade) {
+		reg->min_holdoff = CASCADE_HOLDOFF_NS;
+		_start_cascade();
+	}
+	else {
+		_start_mark();
+	}
+	/* The spi dma mode may have reconfigured the channel */
+	if (HAL_DMA_Init(htmr->hdma[DUT_IC_DMA_ID]) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	if (HAL_TIM_IC_Start_DMA(htmr, DUT_IC_CHANNEL, (uint32_t*)dut_ic.buf, DUT_IC_BUF_SIZE) != HAL_OK) {
 		_Error_Handler(__FILE__, __LINE__);
 	}
 	HAL_NVIC_DisableIRQ(DUT_IC_GPIO_IRQ);
 	return 0;
 }
 
+/* Latches the buffer position on every DUT_IC_MARK_TICK, the source is the
+ * remaining count of the capture dma or the interrupt position */
+static void _start_mark() {
+	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
+	DMA_HandleTypeDef *hmark_dma = &(dut_ic.hmark_dma);
+	TIM_OC_InitTypeDef sConfigOC = {0};
+	uint32_t src = (uint32_t)&(DUT_IC_DMA_INST->CNDTR);
+
+	if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
+		src = (uint32_t)&(dut_ic.int_pos);
+	}
+	if (HAL_DMA_Init(hmark_dma) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sConfigOC.OCMode = TIM_OCMODE_TIMING;
+	sConfigOC.Pulse = DUT_IC_MARK_TICK;
+	if (HAL_TIM_OC_ConfigChannel(htmr, &sConfigOC, DUT_IC_MARK_CHANNEL) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	hmark_dma->XferCpltCallback = _resolve_marks;
+	hmark_dma->XferHalfCpltCallback = _resolve_marks;
+	if (HAL_DMA_Start_IT(hmark_dma, src, (uint32_t)dut_ic.mark, DUT_IC_MARK_SIZE) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	__HAL_TIM_ENABLE_DMA(htmr, DUT_IC_MARK_DMA_SRC);
+}
+
+/* The cascade timer counts the lower 16 bits and clocks DUT_IC_INST with its
+ * update, a capture of DUT_IC_INST triggers the capture of the lower bits */
+static void _start_cascade() {
+	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
+	TIM_HandleTypeDef *hcas = &(dut_ic.hcas);
+	TIM_SlaveConfigTypeDef sSlaveConfig = {0};
+	TIM_MasterConfigTypeDef sMasterConfig = {0};
+	TIM_IC_InitTypeDef sConfigIC = {0};
+
+	if (HAL_TIM_Base_Init(hcas) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+	sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+	if (HAL_TIMEx_MasterConfigSynchronization(hcas, &sMasterConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sSlaveConfig.SlaveMode = TIM_SLAVEMODE_DISABLE;
+	sSlaveConfig.InputTrigger = DUT_IC_CASCADE_TRG;
+	if (HAL_TIM_SlaveConfigSynchro(hcas, &sSlaveConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sConfigIC.ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+	sConfigIC.ICSelection = TIM_ICSELECTION_TRC;
+	sConfigIC.ICPrescaler = TIM_ICPSC_DIV1;
+	if (HAL_TIM_IC_ConfigChannel(hcas, &sConfigIC, TIM_CHANNEL_1) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+
+	/* The compare pulse is sent on every capture of channel 1 */
+	sSlaveConfig.SlaveMode = TIM_SLAVEMODE_EXTERNAL1;
+	sSlaveConfig.InputTrigger = DUT_IC_CASCADE_ITR;
+	if (HAL_TIM_SlaveConfigSynchro(htmr, &sSlaveConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sMasterConfig.MasterOutputTrigger = TIM_TRGO_OC1;
+	if (HAL_TIMEx_MasterConfigSynchronization(htmr, &sMasterConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+
+	if (HAL_DMA_Init(&dut_ic.hcas_dma) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	if (HAL_DMA_Start(&dut_ic.hcas_dma, (uint32_t)&(DUT_IC_CASCADE_INST->CCR1), (uint32_t)dut_ic.cas_buf, DUT_IC_BUF_SIZE) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	__HAL_TIM_ENABLE_DMA(hcas, TIM_DMA_CC1);
+	if (HAL_TIM_IC_Start(hcas, TIM_CHANNEL_1) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+}
+
+/* Reads the current count so edges can be extended to 64 bit, the two halves
+ * may be a period apart which is far inside the signed range */
+static void _update_cascade() {
+	uint32_t now = DUT_IC_INST->CNT << 16;
+
+	now |= DUT_IC_CASCADE_INST->CNT & 0xFFFF;
+	dut_ic.cas_tick += (uint32_t)(now - dut_ic.cas_now);
+	dut_ic.cas_now = now;
+}
+
+static uint64_t _get_cascade_tick(uint16_t hi, uint16_t lo) {
+	uint32_t count;
+
+	/* Right after a wrap the upper capture has usually not counted it yet,
+	 * an edge that lands inside the skew of the wrap is ambiguous */
+	if (lo < DUT_IC_CASCADE_SKEW) {
+		hi++;
+	}
+	count = ((uint32_t)hi << 16) | lo;
+	return dut_ic.cas_tick + (int32_t)(count - dut_ic.cas_now);
+}
+
+/* Counts the edges with DUT_IC_INST clocked by the pin, the cascade timer
+ * counts its updates as the upper 16 bits */
+static void _start_freq() {
+	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
+	TIM_HandleTypeDef *hcas = &(dut_ic.hcas);
+	TIM_IC_InitTypeDef* ctmr_ic = &(dut_ic.ctmr_ic);
+	TIM_SlaveConfigTypeDef sSlaveConfig = {0};
+	TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+	ctmr_ic->ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+	if (dut_ic.mode.trig_edge == DUT_IC_EDGE_FALLING) {
+		ctmr_ic->ICPolarity = TIM_INPUTCHANNELPOLARITY_FALLING;
+	}
+	if (HAL_TIM_IC_ConfigChannel(htmr, ctmr_ic, DUT_IC_CHANNEL) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+	sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+	if (HAL_TIMEx_MasterConfigSynchronization(htmr, &sMasterConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+
+	if (HAL_TIM_Base_Init(hcas) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+	if (HAL_TIMEx_MasterConfigSynchronization(hcas, &sMasterConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	sSlaveConfig.SlaveMode = TIM_SLAVEMODE_EXTERNAL1;
+	sSlaveConfig.InputTrigger = DUT_IC_CASCADE_TRG;
+	if (HAL_TIM_SlaveConfigSynchro(hcas, &sSlaveConfig) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+
+	_set_freq_phase(0);
+	dut_ic.gate_duty = 0;
+	dut_ic.gate_len = (uint64_t)dut_ic.reg->gate_ms * (SystemCoreClock / 1000);
+	__HAL_TIM_SET_COUNTER(htmr, 0);
+	__HAL_TIM_SET_COUNTER(hcas, 0);
+	if (HAL_TIM_Base_Start(hcas) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	if (HAL_TIM_Base_Start(htmr) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	_read_freq_gate(&dut_ic.gate_start, &dut_ic.gate_cnt);
+}
+
+/* Clocks DUT_IC_INST with the edges or, gated by the pin level, with the
+ * ticks of the high time. The trigger may only change while the slave mode is
+ * disabled, the counter then runs on the internal clock for a few ticks. */
+static void _set_freq_phase(uint8_t duty) {
+	uint32_t ts = TIM_TS_TI1FP1;
+	uint32_t sms = TIM_SLAVEMODE_EXTERNAL1;
+
+	if (duty) {
+		sms = TIM_SLAVEMODE_GATED;
+	}
+	else if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
+		ts = TIM_TS_TI1F_ED;
+	}
+	if ((DUT_IC_INST->SMCR & TIM_SMCR_TS) != ts) {
+		DUT_IC_INST->SMCR &= ~TIM_SMCR_SMS;
+		MODIFY_REG(DUT_IC_INST->SMCR, TIM_SMCR_TS, ts);
+	}
+	MODIFY_REG(DUT_IC_INST->SMCR, TIM_SMCR_SMS, sms);
+}
+
+static uint32_t _read_freq_count() {
+	uint16_t lo;
+	uint16_t hi;
+
+	do {
+		lo = DUT_IC_INST->CNT;
+		hi = DUT_IC_CASCADE_INST->CNT;
+		if (lo < DUT_IC_CASCADE_SKEW) {
+			/* The update reaches the upper count a few ticks after the wrap */
+			hi = DUT_IC_CASCADE_INST->CNT;
+		}
+	} while ((uint16_t)DUT_IC_INST->CNT < lo);
+	return ((uint32_t)hi << 16) | lo;
+}
+
+/* Takes the middle of the ticks around the read, reads that got interrupted
+ * are repeated */
+static void _read_freq_gate(uint64_t *tick, uint32_t *count) {
+	uint64_t end;
+
+	do {
+		*tick = get_tick();
+		*count = _read_freq_count();
+		end = get_tick();
+	} while (end - *tick > FREQ_READ_TICKS);
+	*tick += (end - *tick) / 2;
+}
+
+/* Ends a gate once it is long enough and alternates between counting edges
+ * and the high time */
+static void _poll_freq() {
+	tmr_t *reg = dut_ic.reg;
+	uint64_t tick;
+	uint64_t elapsed;
+	uint32_t count;
+	uint32_t amount;
+
+	if (get_tick() - dut_ic.gate_start < dut_ic.gate_len) {
+		return;
+	}
+	_read_freq_gate(&tick, &count);
+	_set_freq_phase(!dut_ic.gate_duty);
+	elapsed = tick - dut_ic.gate_start;
+	amount = count - dut_ic.gate_cnt;
+	if (dut_ic.gate_duty) {
+		if (amount > elapsed) {
+			amount = elapsed;
+		}
+		if (dut_ic.mode.trig_edge == DUT_IC_EDGE_FALLING) {
+			/* The inverted input counts the low time */
+			amount = elapsed - amount;
+		}
+		reg->duty = (uint16_t)((uint64_t)amount * 10000 / elapsed);
+	}
+	else {
+		reg->edge_count = amount;
+		reg->gate_tick = elapsed;
+		if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
+			amount /= 2;
+		}
+		reg->freq = (uint32_t)(((uint64_t)amount * SystemCoreClock + elapsed / 2) / elapsed);
+	}
+	reg->gate_count++;
+	REG_SNAP_CHANGED(REG_SNAP_TMR);
+	dut_ic.gate_duty = !dut_ic.gate_duty;
+	dut_ic.gate_start = tick;
+	dut_ic.gate_cnt = count;
+}
+
 /******************************************************************************/
 void poll_dut_ic() {
-	TIM_HandleTypeDef *htmr = &(dut_ic.htmr);
-	uint32_t of_tick = 0;
-	uint8_t dma_index;
+	if (dut_ic.mode.freq) {
+		_poll_freq();
+		return;
+	}
+	_flush_tmr_buf(_get_position());
+}
+
+uint8_t get_dut_ic_fill() {
+	uint32_t waiting;
+
+	if (dut_ic.mode.freq) {
+		return 0;
+	}
+	waiting = _get_position() - dut_ic.rd_pos;
+	if (waiting > DUT_IC_BUF_SIZE) {
+		return 100;
+	}
+	return waiting * 100 / DUT_IC_BUF_SIZE;
+}
+
+/* Absolute position the next edge is written to, the filled halves may be one
+ * half behind if the dma interrupt is pending */
+static uint32_t _get_position() {
+	uint32_t half;
+	uint32_t index;
 
-	dma_index = _get_current_index();
+	if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
+		return dut_ic.int_pos;
+	}
+	DIS_INT;
+	half = dut_ic.half_pos;
+	index = DUT_IC_BUF_SIZE - TIMER_REMAINING_BUF(dut_ic.htmr_dma);
+	EN_INT;
+	return half + ((index - half) & (DUT_IC_BUF_SIZE - 1));
+}
 
-	if (DUT_IC_OV_OCCURED(htmr)) {
-		DUT_IC_OV_CLEAR(htmr);
-		of_tick = OVERFLOW_TICK_VAL;
+/* Converts the latched marks to absolute positions, runs for every mark so
+ * it is never more than a buffer behind */
+static void _resolve_marks(DMA_HandleTypeDef *hdma) {
+	uint32_t pos = _get_position();
+	uint8_t wr = (DUT_IC_MARK_SIZE - TIMER_REMAINING_BUF(dut_ic.hmark_dma)) % DUT_IC_MARK_SIZE;
+
+	while (dut_ic.mark_rd != wr) {
+		uint16_t mark = dut_ic.mark[dut_ic.mark_rd];
+		uint8_t last = (uint8_t)(dut_ic.epoch_wr - 1) % DUT_IC_EPOCH_SIZE;
+		uint32_t back;
+
+		if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
+			back = (uint16_t)((uint16_t)pos - mark);
+		}
+		else {
+			back = (pos - (DUT_IC_BUF_SIZE - mark)) & (DUT_IC_BUF_SIZE - 1);
+		}
+		/* Overflows without edges between them share an entry, if the poll
+		 * stalls that long the remaining ones are also added to the last */
+		if (dut_ic.epoch_wr != dut_ic.epoch_rd &&
+				(dut_ic.epoch[last].pos == pos - back ||
+				(uint8_t)(dut_ic.epoch_wr - dut_ic.epoch_rd) >= DUT_IC_EPOCH_SIZE)) {
+			dut_ic.epoch[last].amount++;
+		}
+		else {
+			dut_ic.epoch[dut_ic.epoch_wr % DUT_IC_EPOCH_SIZE].pos = pos - back;
+			dut_ic.epoch[dut_ic.epoch_wr % DUT_IC_EPOCH_SIZE].amount = 1;
+			dut_ic.epoch_wr++;
+		}
+		dut_ic.mark_rd = (dut_ic.mark_rd + 1) % DUT_IC_MARK_SIZE;
 	}
+}
+
+/* Moves past the marks latched before the next edge */
+static void _pass_marks() {
+	DIS_INT;
+	while (dut_ic.epoch_rd != dut_ic.epoch_wr) {
+		tmr_epoch_t *epoch = &dut_ic.epoch[dut_ic.epoch_rd % DUT_IC_EPOCH_SIZE];
 
-	_flush_tmr_buf(dma_index, of_tick);
+		if ((int32_t)(dut_ic.rd_pos - epoch->pos) < 0) {
+			break;
+		}
+		dut_ic.of_tick += (uint64_t)epoch->amount * OVERFLOW_TICK_VAL;
+		dut_ic.wrapped = 0;
+		dut_ic.prev_val = 0;
+		dut_ic.epoch_rd++;
+	}
+	EN_INT;
+}
 
-	if (of_tick){
+/* Skips the edges that were overwritten before they were read */
+static void _skip_lost(uint32_t pos) {
+	uint32_t lost = pos - DUT_IC_BUF_SIZE / 2 - dut_ic.rd_pos;
 
-		dma_index = _get_current_index();
-		_flush_tmr_buf(dma_index, of_tick);
+	drop_trace(SOURCE_DUT_IC, lost);
+	if (lost & 1) {
+		if (dut_ic.initial_level == EVENT_TYPE_FALLING) {
+			dut_ic.initial_level = EVENT_TYPE_RISING;
+		}
+		else {
+			dut_ic.initial_level = EVENT_TYPE_FALLING;
+		}
 	}
-	dut_ic.of_tick += of_tick;
+	dut_ic.rd_pos += lost;
+	dut_ic.prev_val = 0;
+	dut_ic.has_last = 0;
 }
 
-static uint8_t _get_current_index() {
-	uint8_t dma_index;
+/* Sorts a difference into the histogram and adds it to the sums, the sums are
+ * relative to the first difference so jitter of millions of edges fits */
+static void _add_hist(uint32_t diff, uint16_t edge) {
+	tmr_t *reg = dut_ic.reg;
+	uint32_t bucket;
+	int64_t dev;
 
 	if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
-		do {
-			dma_index = dut_ic.int_index;
-		} while (dma_index != dut_ic.int_index);
+		if (dut_ic.mode.hist_pulse == DUT_IC_HIST_HIGH && edge != EVENT_TYPE_FALLING) {
+			return;
+		}
+		if (dut_ic.mode.hist_pulse == DUT_IC_HIST_LOW && edge != EVENT_TYPE_RISING) {
+			return;
+		}
 	}
-	else {
-		uint32_t dma_bytes_to_go;
-		do {
-			dma_bytes_to_go = TIMER_REMAINING_BUF(dut_ic.htmr_dma);
-		} while (dma_bytes_to_go != TIMER_REMAINING_BUF(dut_ic.htmr_dma));
-		dma_index = sizeof(dut_ic.buf)/sizeof(dut_ic.buf[0]) - dma_bytes_to_go;
+	if (reg->stat_count == 0) {
+		reg->stat_ref = diff;
 	}
+	dev = (int64_t)diff - reg->stat_ref;
+	reg->stat_count++;
+	reg->stat_sum += dev;
+	reg->stat_sum_sq += (uint64_t)dev * (uint64_t)dev;
 
-	return dma_index;
+	if (dut_ic.hist_width == 0) {
+		return;
+	}
+	if (diff < dut_ic.hist_start) {
+		reg->hist_below++;
+		return;
+	}
+	bucket = (diff - dut_ic.hist_start) / dut_ic.hist_width;
+	if (bucket >= dut_ic.hist_numof) {
+		reg->hist_above++;
+	}
+	else {
+		reg->hist[bucket]++;
+	}
 }
 
-static void _flush_tmr_buf(uint8_t dma_index, uint32_t of_tick) {
+static void _flush_tmr_buf(uint32_t pos) {
 	tmr_t *reg = dut_ic.reg;
 	uint16_t edge = EVENT_TYPE_FALLING;
-	uint32_t tick = 0;
-	static uint32_t old_tick = 0;
+	uint64_t tick = 0;
+	uint32_t now;
+	uint16_t val;
+	PROF_START(PROF_FLUSH_TMR_BUF);
 
 	if (dut_ic.mode.trig_edge == DUT_IC_EDGE_RISING) {
 		edge = EVENT_TYPE_RISING;
 	}
-	while (dut_ic.poll_index != dma_index) {
+	if (dut_ic.mode.cascade) {
+		/* The lower capture is transferred after the upper one */
+		uint32_t behind = (pos - (DUT_IC_BUF_SIZE - TIMER_REMAINING_BUF(dut_ic.hcas_dma))) & (DUT_IC_BUF_SIZE - 1);
+
+		if (behind < DUT_IC_BUF_SIZE / 2) {
+			pos -= behind;
+		}
+		_update_cascade();
+	}
+	if (pos - dut_ic.rd_pos > DUT_IC_BUF_SIZE) {
+		_skip_lost(pos);
+	}
+	while (dut_ic.rd_pos != pos) {
+		_pass_marks();
+		val = dut_ic.buf[dut_ic.rd_pos & (DUT_IC_BUF_SIZE - 1)];
+		/* The capture keeps running, check the value was not overwritten */
+		now = _get_position();
+		if (now - dut_ic.rd_pos > DUT_IC_BUF_SIZE) {
+			_skip_lost(now);
+			pos = now;
+			continue;
+		}
 		if (dut_ic.mode.trig_edge == DUT_IC_EDGE_BOTH) {
 			edge = dut_ic.initial_level;
 			if (dut_ic.initial_level == EVENT_TYPE_FALLING) {
@@ -290,25 +863,36 @@ static void _flush_tmr_buf(uint8_t dma_index, uint32_t of_tick) {
 				dut_ic.initial_level = EVENT_TYPE_FALLING;
 			}
 		}
-		if (dut_ic.buf[dut_ic.poll_index] < dut_ic.htmr.Instance->CNT) {
-			tick = dut_ic.of_tick + dut_ic.buf[dut_ic.poll_index] + of_tick;
+		if (dut_ic.mode.cascade) {
+			tick = _get_cascade_tick(val, dut_ic.cas_buf[dut_ic.rd_pos & (DUT_IC_BUF_SIZE - 1)]);
 		}
 		else {
-			tick = dut_ic.of_tick + dut_ic.buf[dut_ic.poll_index];
+			if (!dut_ic.wrapped && (val < DUT_IC_MARK_TICK || val < dut_ic.prev_val)) {
+				dut_ic.wrapped = 1;
+			}
+			dut_ic.prev_val = val;
+			tick = dut_ic.of_tick + val;
+			if (!dut_ic.wrapped) {
+				tick -= OVERFLOW_TICK_VAL;
+			}
 		}
 		store_tick_from_buf(SOURCE_DUT_IC, edge, tick);
-		if (tick > old_tick && dut_ic.poll_index > 0) {
-			uint32_t diff = tick - old_tick;
+		if (tick > dut_ic.last_tick && dut_ic.has_last) {
+			uint32_t diff = (uint32_t)(tick - dut_ic.last_tick);
 			if (reg->max_tick < diff) {
 				reg->max_tick = diff;
 			}
 			if (reg->min_tick > diff) {
 				reg->min_tick = diff;
 			}
+			_add_hist(diff, edge);
 		}
-		old_tick = tick;
-		dut_ic.poll_index++;
+		dut_ic.last_tick = tick;
+		dut_ic.has_last = 1;
+		dut_ic.rd_pos++;
 	}
+	REG_SNAP_CHANGED(REG_SNAP_TMR);
+	PROF_END(PROF_FLUSH_TMR_BUF);
 }
 
 void update_dut_ic_inputs() {
@@ -317,6 +901,10 @@ void update_dut_ic_inputs() {
 /******************************************************************************/
 /*           Interrupt Handling                                               */
 /******************************************************************************/
+void dut_ic_half_cplt() {
+	dut_ic.half_pos += DUT_IC_BUF_SIZE / 2;
+}
+
 /**
  * @brief This function handles dut_ic dma event interrupt.
  */
@@ -324,10 +912,23 @@ void DUT_IC_DMA_INT() {
 	HAL_DMA_IRQHandler(&dut_ic.htmr_dma);
 }
 
+/**
+ * @brief This function handles dut_ic overflow mark dma interrupt.
+ */
+void DUT_IC_MARK_DMA_INT() {
+	HAL_DMA_IRQHandler(&dut_ic.hmark_dma);
+}
+
 /**
  * @brief Trigger on edge, must be quick and save counter value in buffer.
+ *
+ * The position is taken before the counter so an edge is never behind a mark
+ * that was latched after its value.
  */
 void DUT_IC_GPIO_INT() {
+	uint32_t pos;
+
 	EXTI->PR = DUT_IC_Pin;
-	dut_ic.buf[dut_ic.int_index++] = dut_ic.htmr.Instance->CNT;
+	pos = dut_ic.int_pos++;
+	dut_ic.buf[pos & (DUT_IC_BUF_SIZE - 1)] = dut_ic.htmr.Instance->CNT;
 }
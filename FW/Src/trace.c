@@ -14,54 +14,434 @@
  * @author			Kevin Weiss
  * @date			12.03.2019
  * @brief			Used for logging traces.
+ *
+ * A trigger condition limits the trace to a window around the trigger like a
+ * logic analyser. Until the trigger the last pre_depth events are kept aside
+ * without sequence numbers, the trigger moves them to the trace before the
+ * following post_depth events. Events outside the window are not counted as
+ * lost.
  * @}
  ******************************************************************************
  */
 
 /* Includes *******************************************************************/
+#include <errno.h>
 #include <string.h>
 #include <stdint.h>
 
+#include "stm32f1xx_hal.h"
+
 #include "mm_typedefs.h"
 #include "app_common.h"
+#include "app_reg.h"
 
 #include "trace.h"
 
+/* Private defines ************************************************************/
+/** @brief		Most events kept before the trigger. */
+#define TRACE_PRE_SIZE		(64)
+
+/** @brief		Fills the guard gap below the stack, the stack overwrites it */
+#define STACK_CANARY		(0xC0FFEE5A)
+
 /* Private macros *************************************************************/
 /** @brief		Gets the buffer size of the number of traces. */
 #define NUM_OF_TRACES	(sizeof(((map_t*)0)->trace.tick)/sizeof(((map_t*)0)->trace.tick[0]))
 
+/** @brief		Gets the amount of sources with a dropped counter. */
+#define NUM_OF_SOURCES	(sizeof(((map_t*)0)->trace.dropped)/sizeof(((map_t*)0)->trace.dropped[0]))
+
+/* Private enums/structs ******************************************************/
+/** @brief		An event waiting in the stream ring */
+typedef struct {
+	uint64_t tick; /**< The tick when the event occurred */
+	uint32_t seq; /**< The sequence number of the event */
+	uint16_t value; /**< The value of the event */
+	uint8_t source; /**< The source of the event */
+	uint8_t tick_div; /**< The tick divisor of the event */
+} trace_rec_t;
+
+/** @brief		Events queued until the interface drains them */
+typedef struct {
+	trace_rec_t *rec; /**< The ring */
+	uint16_t size; /**< Amount of events the ring holds */
+	uint16_t rd; /**< Index of the oldest event */
+	uint16_t level; /**< Amount of events in the ring */
+	uint16_t pos; /**< Amount of drained events, wraps */
+	uint8_t enabled; /**< Events go to the ring instead of the registers */
+} trace_stream_t;
+
+/** @brief		The capture window */
+typedef struct {
+	trace_rec_t pre[TRACE_PRE_SIZE]; /**< Events before the trigger */
+	uint8_t rd; /**< Index of the oldest event before the trigger */
+	uint8_t level; /**< Amount of events before the trigger */
+	uint8_t depth; /**< Most events kept before the trigger */
+	uint8_t cond; /**< The TRACE_TRIG condition */
+	uint8_t state; /**< The TRACE_TRIG_STATE */
+	uint16_t post; /**< Events left in the window, 0 for no end */
+	uint32_t count; /**< DUT_IC events left until the count trigger */
+} trace_trig_t;
+
 /* Private variables **********************************************************/
+#ifdef TRACE_RING_BYTES
+/** @brief		Host builds have no linker script, the ring is an array */
+static trace_rec_t _strace_ring[TRACE_RING_BYTES / sizeof(trace_rec_t)];
+/** @brief		End of the ring */
+#define _etrace_ring	(&_strace_ring[TRACE_RING_BYTES / sizeof(trace_rec_t)])
+/** @brief		The guard gap, nothing writes it unless the stack overflows */
+static uint32_t _sstack_guard[64];
+/** @brief		End of the guard gap */
+#define _estack_guard	(&_sstack_guard[64])
+#else
+/** @brief		Start of the RAM the linker script leaves for the ring */
+extern trace_rec_t _strace_ring[];
+/** @brief		End of the RAM the linker script leaves for the ring */
+extern trace_rec_t _etrace_ring[];
+/** @brief		Start of the guard gap between the ring and the stack */
+extern uint32_t _sstack_guard[];
+/** @brief		End of the guard gap, the lowest address of the stack */
+extern uint32_t _estack_guard[];
+#endif
+
 static trace_t *trace;
+static trace_stream_t stream = {0};
+static trace_trig_t trig = {0};
+
+/* Private function prototypes ************************************************/
+static void _store(uint8_t tick_div, uint8_t source, uint16_t value,
+		uint64_t tick);
+static void _record(uint8_t tick_div, uint8_t source, uint16_t value,
+		uint64_t tick);
+static uint8_t _in_window(uint8_t tick_div, uint8_t source, uint16_t value,
+		uint64_t tick);
+static void _fire(uint64_t tick);
+static void _drop(uint8_t source, uint32_t amount);
+static uint16_t _pack_record(uint8_t *buf, uint8_t source, uint8_t tick_div,
+		uint16_t value, uint64_t tick, uint32_t seq);
 
 /******************************************************************************/
 /*           Initialization                                                   */
 /******************************************************************************/
 void init_trace(map_t *reg) {
 	trace = &(reg->trace);
+	stream.rec = _strace_ring;
+	stream.size = _etrace_ring - _strace_ring;
+	trace->stream_size = stream.size;
+	for (uint32_t *p = _sstack_guard; p < _estack_guard; p++) {
+		*p = STACK_CANARY;
+	}
+	commit_trace();
+}
+
+error_t commit_trace() {
+	if (trace->mode.init) {
+		return 0;
+	}
+	if (trace->mode.trig >= TRACE_TRIG_NUMOF
+			|| trace->pre_depth > TRACE_PRE_SIZE) {
+		trace->mode.init = 1;
+		return -EINVAL;
+	}
+	DIS_INT;
+	stream.rd = 0;
+	stream.level = 0;
+	stream.pos = 0;
+	/* A stack that used the whole guard gap may reach into the ring */
+	if (_sstack_guard[0] != STACK_CANARY) {
+		trace->mode.stream = 0;
+	}
+	stream.enabled = trace->mode.stream;
+	trace->stream_level = 0;
+	trace->stream_high_water = 0;
+	trace->stream_overruns = 0;
+	trig.rd = 0;
+	trig.level = 0;
+	trig.depth = trace->pre_depth;
+	trig.cond = trace->mode.trig;
+	trig.post = trace->post_depth;
+	trig.count = trace->trig_count;
+	trig.state = TRACE_TRIG_OFF;
+	if (trig.cond != TRACE_TRIG_NONE) {
+		trig.state = TRACE_TRIG_ARMED;
+		for (uint32_t i = 0; i < NUM_OF_TRACES; i++) {
+			trace->source[i] = SOURCE_NONE;
+		}
+	}
+	trace->trig_state = trig.state;
+	trace->trig_seq = 0;
+	trace->trig_time = 0;
+	trace->mode.init = 1;
+	EN_INT;
+	return 0;
 }
 
 /******************************************************************************/
 /*           Functions                                                        */
 /******************************************************************************/
+void check_stack_guard() {
+	uint32_t *p = _sstack_guard;
+
+	/* The stack grows down so it overwrites the canary from the top */
+	while (p < _estack_guard && *p == STACK_CANARY) {
+		p++;
+	}
+	trace->stack_guard_used = (uint8_t*)_estack_guard - (uint8_t*)p;
+	if (p == _sstack_guard && stream.enabled) {
+		DIS_INT;
+		stream.enabled = 0;
+		EN_INT;
+		trace->mode.stream = 0;
+	}
+}
+
 void store_gpio_trace(uint8_t tick_div, uint8_t source, uint16_t value) {
+	_store(tick_div, source, value, get_tick64_div(tick_div));
+	REG_SNAP_CHANGED(REG_SNAP_TRACE);
+}
+
+void store_tick_from_buf(uint8_t source, uint16_t value, uint64_t tick) {
+	/* Called from the polling loop so the gpio interrupts can preempt it */
+	DIS_INT;
+	_store(0, source, value, tick);
+	EN_INT;
+}
+
+static void _store(uint8_t tick_div, uint8_t source, uint16_t value,
+		uint64_t tick) {
+	if (trig.state != TRACE_TRIG_OFF
+			&& !_in_window(tick_div, source, value, tick)) {
+		return;
+	}
+	_record(tick_div, source, value, tick);
+}
+
+static void _record(uint8_t tick_div, uint8_t source, uint16_t value,
+		uint64_t tick) {
+	uint32_t seq = trace->next_seq++;
+
+	if (stream.enabled) {
+		trace_rec_t *rec;
+
+		if (stream.level >= stream.size) {
+			trace->stream_overruns++;
+			_drop(source, 1);
+			return;
+		}
+		rec = &stream.rec[(stream.rd + stream.level) % stream.size];
+		rec->tick = tick;
+		rec->seq = seq;
+		rec->value = value;
+		rec->source = source;
+		rec->tick_div = tick_div;
+		stream.level++;
+		trace->stream_level = stream.level;
+		if (trace->stream_high_water < stream.level) {
+			trace->stream_high_water = stream.level;
+		}
+		return;
+	}
+	_drop(trace->source[trace->index], 1);
 	trace->source[trace->index] = source;
 	trace->tick_div[trace->index] = tick_div;
 	trace->value[trace->index] = value;
-	trace->tick[trace->index] = get_tick32_div(tick_div);
+	trace->tick[trace->index] = (uint32_t)tick;
+	trace->tick_hi[trace->index] = (uint32_t)(tick >> 32);
+	trace->seq[trace->index] = seq;
+	trace->count++;
 	trace->index++;
 	if (trace->index >= NUM_OF_TRACES) {
 		trace->index = 0;
 	}
 }
 
-void store_tick_from_buf(uint8_t source, uint16_t value, uint32_t tick) {
-	trace->source[trace->index] = source;
-	trace->tick_div[trace->index] = 0;
-	trace->value[trace->index] = value;
-	trace->tick[trace->index] = tick;
-	trace->index++;
-	if (trace->index >= NUM_OF_TRACES) {
-		trace->index = 0;
+/* Keeps the events before the trigger aside and ends the window after the
+ * post trigger events, returns 1 if the event is traced */
+static uint8_t _in_window(uint8_t tick_div, uint8_t source, uint16_t value,
+		uint64_t tick) {
+	if (trig.state == TRACE_TRIG_ARMED) {
+		uint8_t fire = 0;
+
+		if (trig.cond == TRACE_TRIG_EVENT) {
+			fire = source == trace->trig_source && value == trace->trig_value;
+		}
+		else if (trig.cond == TRACE_TRIG_COUNT && source == SOURCE_DUT_IC) {
+			fire = trig.count <= 1;
+			trig.count--;
+		}
+		else if (trig.cond == TRACE_TRIG_TICK) {
+			fire = (tick << tick_div) >= trace->trig_tick;
+		}
+		if (!fire) {
+			trace_rec_t *rec;
+
+			if (trig.depth == 0) {
+				return 0;
+			}
+			if (trig.level == trig.depth) {
+				trig.rd = (trig.rd + 1) % trig.depth;
+				trig.level--;
+			}
+			rec = &trig.pre[(trig.rd + trig.level) % trig.depth];
+			rec->tick = tick;
+			rec->value = value;
+			rec->source = source;
+			rec->tick_div = tick_div;
+			trig.level++;
+			return 0;
+		}
+		if (trig.cond == TRACE_TRIG_TICK) {
+			_fire(trace->trig_tick);
+		}
+		else {
+			_fire(tick << tick_div);
+		}
+	}
+	if (trig.state != TRACE_TRIG_RUNNING) {
+		return 0;
+	}
+	if (trig.post != 0 && --trig.post == 0) {
+		trig.state = TRACE_TRIG_DONE;
+		trace->trig_state = trig.state;
+	}
+	return 1;
+}
+
+/* Traces the events kept before the trigger, the following events are in the
+ * window */
+static void _fire(uint64_t tick) {
+	for (uint8_t i = 0; i < trig.level; i++) {
+		trace_rec_t *rec = &trig.pre[(trig.rd + i) % trig.depth];
+
+		_record(rec->tick_div, rec->source, rec->value, rec->tick);
+	}
+	trig.level = 0;
+	trig.state = TRACE_TRIG_RUNNING;
+	trace->trig_state = trig.state;
+	trace->trig_seq = trace->next_seq;
+	trace->trig_time = tick;
+	REG_SNAP_CHANGED(REG_SNAP_TRACE);
+}
+
+void trigger_trace_write(uint32_t index, uint16_t size) {
+	DIS_INT;
+	if (trig.state == TRACE_TRIG_ARMED && trig.cond == TRACE_TRIG_WRITE
+			&& trace->trig_addr >= index && trace->trig_addr < index + size) {
+		_fire(get_tick());
+	}
+	EN_INT;
+}
+
+void drop_trace(uint8_t source, uint32_t amount) {
+	DIS_INT;
+	if (trig.state != TRACE_TRIG_OFF && trig.state != TRACE_TRIG_RUNNING) {
+		/* Outside of the window nothing is traced */
+		EN_INT;
+		return;
+	}
+	trace->next_seq += amount;
+	_drop(source, amount);
+	EN_INT;
+}
+
+static void _drop(uint8_t source, uint32_t amount) {
+	if (source != SOURCE_NONE && source <= NUM_OF_SOURCES) {
+		trace->dropped[source - 1] += amount;
+	}
+}
+
+/******************************************************************************/
+uint16_t dump_trace(uint16_t start, const uint32_t *since, uint8_t *buf,
+		uint16_t max_size, uint16_t *total) {
+	/* The next entry to write is the oldest one once the ring wrapped */
+	uint32_t index = trace->index;
+	uint16_t size = 0;
+
+	*total = 0;
+	for (uint32_t i = 0; i < NUM_OF_TRACES; i++) {
+		uint64_t tick;
+		uint32_t seq;
+		uint16_t value;
+		uint8_t tick_div;
+		uint8_t source;
+
+		DIS_INT;
+		source = trace->source[index];
+		tick_div = trace->tick_div[index];
+		value = trace->value[index];
+		tick = ((uint64_t)trace->tick_hi[index] << 32) | trace->tick[index];
+		seq = trace->seq[index];
+		EN_INT;
+		if (++index >= NUM_OF_TRACES) {
+			index = 0;
+		}
+		if (source == SOURCE_NONE) {
+			continue;
+		}
+		/* The sequence numbers wrap so compare the difference */
+		if (since != NULL && (int32_t)(seq - *since) < 0) {
+			continue;
+		}
+		(*total)++;
+		if (*total <= start || size + TRACE_RECORD_SIZE > max_size) {
+			continue;
+		}
+		size += _pack_record(&buf[size], source, tick_div, value, tick, seq);
+	}
+	return size;
+}
+
+error_t drain_trace(uint16_t ack, uint8_t *buf, uint16_t max_size,
+		uint16_t *size, uint16_t *pos, uint16_t *pending) {
+	uint16_t discard;
+	uint16_t index;
+	uint16_t count;
+
+	DIS_INT;
+	discard = ack - stream.pos;
+	if (discard > stream.level) {
+		EN_INT;
+		return ERANGE;
+	}
+	stream.rd = (stream.rd + discard) % stream.size;
+	stream.level -= discard;
+	stream.pos = ack;
+	trace->stream_level = stream.level;
+	index = stream.rd;
+	count = stream.level;
+	EN_INT;
+
+	*pos = ack;
+	*pending = count;
+	if (count > max_size / TRACE_RECORD_SIZE) {
+		count = max_size / TRACE_RECORD_SIZE;
+	}
+	/* Only free slots are written by the interrupts so no need to lock */
+	*size = 0;
+	for (uint16_t i = 0; i < count; i++) {
+		trace_rec_t *rec = &stream.rec[index];
+
+		*size += _pack_record(&buf[*size], rec->source, rec->tick_div,
+				rec->value, rec->tick, rec->seq);
+		if (++index >= stream.size) {
+			index = 0;
+		}
+	}
+	return 0;
+}
+
+static uint16_t _pack_record(uint8_t *buf, uint8_t source, uint8_t tick_div,
+		uint16_t value, uint64_t tick, uint32_t seq) {
+	buf[0] = source;
+	buf[1] = tick_div;
+	buf[2] = (uint8_t)value;
+	buf[3] = (uint8_t)(value >> 8);
+	for (uint8_t i = 0; i < 8; i++) {
+		buf[4 + i] = (uint8_t)(tick >> (8 * i));
 	}
+	buf[12] = (uint8_t)seq;
+	buf[13] = (uint8_t)(seq >> 8);
+	buf[14] = (uint8_t)(seq >> 16);
+	buf[15] = (uint8_t)(seq >> 24);
+	return TRACE_RECORD_SIZE;
 }
@@ -31,7 +31,9 @@
 #include "app_common.h"
 #include "app_defaults.h"
 #include "app_shell_if.h"
+#include "app_bin_if.h"
 #include "app_reg.h"
+#include "prof.h"
 
 #include "gpio.h"
 
@@ -65,7 +67,13 @@ typedef struct {
 	/** @brief Function pointer to the tx (either DMA or INT) */
 	HAL_StatusTypeDef (*tx_data_fxn)(UART_HandleTypeDef*, uint8_t*, uint16_t);
 	char *str; /**< String buffer */
+	char *tx_str; /**< Transmit buffer, same as str if not double buffered */
 	uint32_t buf_size; /**< String buffer size */
+	uint16_t rd; /**< Read index of the receive ring, 0 if not double buffered */
+	uint8_t discard_line; /**< Drops received bytes up to the next line end */
+	uint16_t discard; /**< Amount of received bytes still to drop */
+	uint16_t rx_last; /**< Amount received of a partial frame at rx_tick */
+	uint32_t rx_tick; /**< Tick a byte of a partial frame was last received */
 	uint8_t mask_msb; /**< Used for masking bits */
 	uart_mode_t mode; /**< Mode of uart */
 	uint8_t access; /**< Access level of uart */
@@ -76,16 +84,30 @@ typedef struct {
 /** @brief	Checks the uart register to see if any data is waiting */
 #define IS_RX_WAITING(x)	(HAL_IS_BIT_SET(x, USART_CR3_DMAR))
 
+/** @brief	Double buffered uarts receive into a circular ring */
+#define IS_RX_RING(dev)		((dev)->tx_str != (dev)->str)
+
+/** @brief	Checks if the uart is still sending the last response */
+#define IS_TX_BUSY(x)		((x)->gState != HAL_UART_STATE_READY)
+
 /* Private function prototypes ************************************************/
 static void _init_gpio();
 
 static error_t _poll_uart(uart_dev_t *dev);
 static error_t _tx_str(uart_dev_t *port_uart);
 static error_t _rx_str(uart_dev_t *dev);
+static error_t _rx_frame(uart_dev_t *dev, uint16_t rx_amount);
+static uint16_t _discard_rx(uart_dev_t *dev, uint16_t rx_amount);
+static void _drop_rx(uart_dev_t *dev, uint16_t size);
+static char *_take_cmd(uart_dev_t *dev, uint16_t size);
 static error_t _xfer_complete(uart_dev_t *dev);
 static inline int32_t _get_rx_amount(uart_dev_t *dev);
+static inline char *_rx_char(uart_dev_t *dev, uint16_t index);
 static inline void _update_tx_count(uart_dev_t* dev, uint16_t tx_amount);
 static inline void _update_rx_count(uart_dev_t* dev, uint16_t rx_amount);
+static inline void _confirm_if_baud(uart_dev_t* dev, error_t err);
+static void _poll_if_baud();
+static void _set_baud(uart_dev_t *dev, uint32_t baud);
 
 /* Global functions ***********************************************************/
 extern void _Error_Handler(char *, int);
@@ -96,13 +118,31 @@ static uart_dev_t if_uart = {0};
 
 static char if_str_buf[UART_IF_BUF_SIZE] = {0};
 
+static char if_tx_str_buf[UART_IF_BUF_SIZE] = {0};
+
 static char dut_str_buf[UART_DUT_BUF_SIZE] = {0};
 
 static uart_t* dut_uart_reg;
 
+static uint32_t* if_baud_reg;
+
+/** @brief	if baudrate to change to after the response is sent */
+static uint32_t if_pending_baud = 0;
+
+/** @brief	if baudrate to fall back to, 0 if the current one is confirmed */
+static uint32_t if_fallback_baud = 0;
+
+/** @brief	tick of the last if baudrate change */
+static uint32_t if_baud_tick = 0;
+
 /** @brief	dma handle for interface receive */
 static DMA_HandleTypeDef hdma_usart_if_rx;
 
+#ifdef IF_UART_DMA_TX_INST
+/** @brief	dma handle for interface transmit */
+static DMA_HandleTypeDef hdma_usart_if_tx;
+#endif
+
 /** @brief	dma handle for dut receive */
 static DMA_HandleTypeDef hdma_usart_dut_rx;
 
@@ -117,6 +157,7 @@ void init_dut_uart(map_t *reg) {
 	uart_dev->tx_data_fxn = HAL_UART_Transmit_IT;
 	uart_dev->access = MM_ACCESS_PERIPHERAL;
 	uart_dev->str = dut_str_buf;
+	uart_dev->tx_str = dut_str_buf;
 	uart_dev->buf_size = sizeof(dut_str_buf)/sizeof(dut_str_buf[0]);
 
 	uart_dev->huart.Instance = DUT_UART_INST;
@@ -129,7 +170,7 @@ void init_dut_uart(map_t *reg) {
 
 	commit_dut_uart();
 
-	sprintf(uart_dev->str, "{\"build_date\":\"%s %s\",\"result\":0}\n",
+	sprintf(uart_dev->tx_str, "{\"build_date\":\"%s %s\",\"result\":0}\n",
 			__DATE__, __TIME__);
 	_tx_str(uart_dev);
 }
@@ -213,6 +254,11 @@ error_t commit_dut_uart() {
 	if (reg->mode.data_bits == APP_UART_DATABITS_7 && !reg->mode.parity) {
 		return EINVAL;
 	}
+	/* A stopped uart does not hold its rx channel, the spi may share it */
+	if (!reg->mode.disable && !(huart->Instance->CR1 & USART_CR1_UE)
+			&& (DUT_UART_RX_DMA_INST->CCR & DMA_CCR_EN)) {
+		return EBUSY;
+	}
 	dut_uart.mode.if_type = reg->mode.if_type;
 	dut_uart.mask_msb = 0xFF;
 	huart->Init.BaudRate = reg->baud;
@@ -278,12 +324,17 @@ error_t commit_dut_uart() {
 /******************************************************************************/
 /*           Initialization IF_UART                                           */
 /******************************************************************************/
-void init_if_uart() {
+void init_if_uart(map_t *reg) {
 	uart_dev_t* uart_dev = &if_uart;
+#ifdef IF_UART_DMA_TX_INST
+	uart_dev->tx_data_fxn = HAL_UART_Transmit_DMA;
+#else
 	uart_dev->tx_data_fxn = HAL_UART_Transmit_IT;
+#endif
 
 	uart_dev->access = MM_ACCESS_INTERFACE;
 	uart_dev->str = if_str_buf;
+	uart_dev->tx_str = if_tx_str_buf;
 	uart_dev->buf_size = sizeof(if_str_buf)/sizeof(if_str_buf[0]);
 	memset(if_uart.str, 0, if_uart.buf_size);
 
@@ -302,7 +353,10 @@ void init_if_uart() {
 	uart_dev->mask_msb = 0xFF;
 	uart_dev->mode.if_type = UART_IF_TYPE_REG;
 
-	sprintf(uart_dev->str, "{\"build_date\":\"%s %s\",\"result\":0}\n",
+	if_baud_reg = &reg->sys.if_baud;
+	*if_baud_reg = DEFAULT_UART_BAUDRATE;
+
+	sprintf(uart_dev->tx_str, "{\"build_date\":\"%s %s\",\"result\":0}\n",
 			__DATE__, __TIME__);
 	_tx_str(uart_dev);
 }
@@ -311,6 +365,9 @@ void init_if_uart_msp() {
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
 	UART_HandleTypeDef* huart = &if_uart.huart;
 	DMA_HandleTypeDef* huart_rx_dma = &hdma_usart_if_rx;
+#ifdef IF_UART_DMA_TX_INST
+	DMA_HandleTypeDef* huart_tx_dma = &hdma_usart_if_tx;
+#endif
 
 	IF_UART_CLK_EN();
 
@@ -330,18 +387,38 @@ void init_if_uart_msp() {
 	huart_rx_dma->Init.MemInc = DMA_MINC_ENABLE;
 	huart_rx_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
 	huart_rx_dma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-	huart_rx_dma->Init.Mode = DMA_NORMAL;
+	huart_rx_dma->Init.Mode = DMA_CIRCULAR;
 	huart_rx_dma->Init.Priority = DMA_PRIORITY_LOW;
 	if (HAL_DMA_Init(huart_rx_dma) != HAL_OK) {
 		_Error_Handler(__FILE__, __LINE__);
 	}
 	__HAL_LINKDMA(huart, hdmarx, (*huart_rx_dma));
 
+#ifdef IF_UART_DMA_TX_INST
+	huart_tx_dma->Instance = IF_UART_DMA_TX_INST;
+	huart_tx_dma->Init.Direction = DMA_MEMORY_TO_PERIPH;
+	huart_tx_dma->Init.PeriphInc = DMA_PINC_DISABLE;
+	huart_tx_dma->Init.MemInc = DMA_MINC_ENABLE;
+	huart_tx_dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	huart_tx_dma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	huart_tx_dma->Init.Mode = DMA_NORMAL;
+	huart_tx_dma->Init.Priority = DMA_PRIORITY_LOW;
+	if (HAL_DMA_Init(huart_tx_dma) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	__HAL_LINKDMA(huart, hdmatx, (*huart_tx_dma));
+#endif
+
 	HAL_NVIC_SetPriority(IF_UART_IRQ, DEFAULT_INT_PRIO, 0);
 	HAL_NVIC_EnableIRQ(IF_UART_IRQ);
 
 	HAL_NVIC_SetPriority(IF_UART_DMA_RX_IRQ, DEFAULT_INT_PRIO, 0);
 	HAL_NVIC_EnableIRQ(IF_UART_DMA_RX_IRQ);
+
+#ifdef IF_UART_DMA_TX_INST
+	HAL_NVIC_SetPriority(IF_UART_DMA_TX_IRQ, DEFAULT_INT_PRIO, 0);
+	HAL_NVIC_EnableIRQ(IF_UART_DMA_TX_IRQ);
+#endif
 }
 
 void deinit_if_uart_msp() {
@@ -350,6 +427,9 @@ void deinit_if_uart_msp() {
 	HAL_GPIO_DeInit(IF_RX_GPIO_Port, IF_RX_Pin);
 	HAL_GPIO_DeInit(IF_TX_GPIO_Port, IF_TX_Pin);
 	HAL_DMA_DeInit(huart->hdmarx);
+#ifdef IF_UART_DMA_TX_INST
+	HAL_DMA_DeInit(huart->hdmatx);
+#endif
 	HAL_NVIC_DisableIRQ(IF_UART_IRQ);
 }
 
@@ -361,9 +441,48 @@ error_t poll_dut_uart() {
 }
 
 error_t poll_if_uart() {
+	_poll_if_baud();
 	return _poll_uart(&if_uart);
 }
 
+error_t set_if_uart_baud(uint32_t baud) {
+	if (baud < IF_UART_MIN_BAUD || baud > IF_UART_MAX_BAUD) {
+		*if_baud_reg = if_uart.huart.Init.BaudRate;
+		return EINVAL;
+	}
+	if (baud != if_uart.huart.Init.BaudRate) {
+		if_pending_baud = baud;
+	}
+	return 0;
+}
+
+static void _poll_if_baud() {
+	UART_HandleTypeDef *huart = &if_uart.huart;
+
+	if (if_pending_baud && !IS_TX_BUSY(huart)) {
+		if_fallback_baud = huart->Init.BaudRate;
+		_set_baud(&if_uart, if_pending_baud);
+		if_pending_baud = 0;
+	} else if (if_fallback_baud &&
+			HAL_GetTick() - if_baud_tick > IF_UART_BAUD_TIMEOUT) {
+		_set_baud(&if_uart, if_fallback_baud);
+		if_fallback_baud = 0;
+	}
+}
+
+static void _set_baud(uart_dev_t *dev, uint32_t baud) {
+	UART_HandleTypeDef *huart = &dev->huart;
+
+	HAL_UART_Abort(huart);
+	huart->Init.BaudRate = baud;
+	if (HAL_UART_Init(huart) != HAL_OK) {
+		_Error_Handler(__FILE__, __LINE__);
+	}
+	*if_baud_reg = baud;
+	if_baud_tick = HAL_GetTick();
+	_xfer_complete(dev);
+}
+
 static error_t _poll_uart(uart_dev_t *dev) {
 	error_t err = 0;
 	UART_HandleTypeDef *huart = &(dev->huart);
@@ -372,10 +491,12 @@ static error_t _poll_uart(uart_dev_t *dev) {
 		err = _rx_str(dev);
 	}
 	else if (huart->TxXferCount == 0) {
-		if (dev->str[dev->buf_size - 1] != 0) {
+		if (!IS_RX_RING(dev) && !dev->discard_line && !dev->discard &&
+				dev->str[dev->buf_size - 1] != 0) {
 			HAL_UART_Abort(huart);
 			parse_command(dev->str, dev->buf_size, dev->access);
 			dev->str[dev->buf_size - 1] = 0;
+			dev->discard_line = 1;
 			dev->tx_data_fxn(huart, (uint8_t*) dev->str, strlen(dev->str));
 		}
 		else {
@@ -394,11 +515,13 @@ static error_t _xfer_complete(uart_dev_t *dev) {
 	error_t err = ENXIO;
 
 	memset(str, 0, dev->buf_size);
+	dev->rd = 0;
+	dev->rx_last = 0;
 	HAL_UART_Abort(huart);
 	if (dev->mode.if_type == UART_IF_TYPE_TX) {
-		memset(str, 'a', dev->buf_size - 3);
-		str[dev->buf_size - 2] = '\n';
-		str[dev->buf_size - 1] = '\0';
+		memset(dev->tx_str, 'a', dev->buf_size - 3);
+		dev->tx_str[dev->buf_size - 2] = '\n';
+		dev->tx_str[dev->buf_size - 1] = '\0';
 		return _tx_str(dev);
 	}
 
@@ -416,47 +539,172 @@ static error_t _xfer_complete(uart_dev_t *dev) {
 }
 
 static error_t _rx_str(uart_dev_t *dev) {
-	char *str = dev->str;
+	char *str;
 	UART_HandleTypeDef *huart = &(dev->huart);
 
 	uint16_t rx_amount;
+	uint16_t size;
 	error_t err = 0;
 
-	rx_amount = _get_rx_amount(dev);
-	if (rx_amount >= 1) {
-		for (int i = 0; i < strlen(str); i++) {
-			str[i] &= dev->mask_msb;
+	rx_amount = _discard_rx(dev, _get_rx_amount(dev));
+	/* A command received while sending waits for the response to finish */
+	if (rx_amount == 0 || IS_TX_BUSY(huart)) {
+		return 0;
+	}
+	if (dev->mode.if_type == UART_IF_TYPE_REG &&
+			is_bin_frame((uint8_t*) _rx_char(dev, 0))) {
+		return _rx_frame(dev, rx_amount);
+	}
+	for (size = 0; size < rx_amount; size++) {
+		*_rx_char(dev, size) &= dev->mask_msb;
+	}
+	for (size = 0; size < rx_amount; size++) {
+		if (*_rx_char(dev, size) == RX_END_CHAR) {
+			break;
 		}
-		if (str[rx_amount - 1] == RX_END_CHAR && _get_rx_amount(dev) != dev->buf_size) {
-			_update_rx_count(dev, strlen(str));
-			HAL_UART_Abort(huart);
+	}
+	if (size == rx_amount || rx_amount == dev->buf_size) {
+		if (!IS_RX_RING(dev) || rx_amount < dev->buf_size - 1) {
+			return 0;
+		}
+		/* A line that does not fit the ring is answered as too long and the
+		 * rest of it is dropped */
+		dev->discard_line = 1;
+	}
+	else {
+		size++;
+	}
+	_update_rx_count(dev, size);
+	str = _take_cmd(dev, size);
+	if (dev->discard_line) {
+		str[dev->buf_size - 1] = RX_END_CHAR;
+	}
 
-			if (rx_amount >= 2 && str[rx_amount - 2] == '\r'){
-				str[rx_amount - 2] = '\n';
-				str[rx_amount - 1] = 0;
-			}
-			if (dev->mode.if_type == UART_IF_TYPE_REG) {
-				err = parse_command(str, dev->buf_size, dev->access);
-			} else if (dev->mode.if_type == UART_IF_TYPE_ECHO) {
-				err = 0;
-			} else if (dev->mode.if_type == UART_IF_TYPE_ECHO_EXT) {
-				int i;
-				for (i = 0; i < strlen(str) - 1; i++) {
-					str[i]++;
-				}
-				err = 0;
-			} else {
-				err = EPROTONOSUPPORT;
-			}
-			_update_tx_count(dev, strlen(str));
-			dev->tx_data_fxn(huart, (uint8_t*) str, strlen(str));
+	if (size >= 2 && str[size - 2] == '\r'){
+		str[size - 2] = '\n';
+		str[size - 1] = 0;
+	}
+	if (dev->mode.if_type == UART_IF_TYPE_REG) {
+		PROF_START(PROF_PARSE_COMMAND);
+		err = parse_command(str, dev->buf_size, dev->access);
+		PROF_END(PROF_PARSE_COMMAND);
+	} else if (dev->mode.if_type == UART_IF_TYPE_ECHO) {
+		err = 0;
+	} else if (dev->mode.if_type == UART_IF_TYPE_ECHO_EXT) {
+		int i;
+		for (i = 0; i < strlen(str) - 1; i++) {
+			str[i]++;
+		}
+		err = 0;
+	} else {
+		err = EPROTONOSUPPORT;
+	}
+	_confirm_if_baud(dev, err);
+	_update_tx_count(dev, strlen(str));
+	dev->tx_data_fxn(huart, (uint8_t*) str, strlen(str));
+	return err;
+}
+
+static error_t _rx_frame(uart_dev_t *dev, uint16_t rx_amount) {
+	UART_HandleTypeDef *huart = &(dev->huart);
+	uint8_t hdr[BIN_HDR_SIZE];
+	uint32_t frame_size;
+	uint8_t *frame;
+	uint16_t tx_amount;
+	error_t err;
+
+	for (int i = 0; i < BIN_HDR_SIZE && i < rx_amount; i++) {
+		hdr[i] = *_rx_char(dev, i);
+	}
+	frame_size = bin_frame_size(hdr, rx_amount);
+	/* Oversized frames are answered right away with an error and the rest
+	 * of the frame is dropped */
+	if (frame_size >= dev->buf_size) {
+		dev->discard = frame_size - rx_amount;
+		frame_size = rx_amount;
+	}
+	else if (frame_size == 0 || rx_amount < frame_size) {
+		/* A frame that stops arriving is dropped so the uart can resync */
+		if (rx_amount != dev->rx_last) {
+			dev->rx_last = rx_amount;
+			dev->rx_tick = HAL_GetTick();
+		}
+		else if (HAL_GetTick() - dev->rx_tick > UART_FRAME_TIMEOUT) {
+			_drop_rx(dev, rx_amount);
 		}
+		return 0;
 	}
+	dev->rx_last = 0;
+	_update_rx_count(dev, frame_size);
+	frame = (uint8_t*) _take_cmd(dev, frame_size);
+
+	PROF_START(PROF_PARSE_FRAME);
+	err = parse_frame(frame, dev->buf_size, &tx_amount, dev->access);
+	PROF_END(PROF_PARSE_FRAME);
+	_confirm_if_baud(dev, err);
+	_update_tx_count(dev, tx_amount);
+	dev->tx_data_fxn(huart, frame, tx_amount);
 	return err;
 }
 
+/* Drops the rest of a line or frame that was too long, returns the amount
+ * left */
+static uint16_t _discard_rx(uart_dev_t *dev, uint16_t rx_amount) {
+	uint16_t size = 0;
+
+	if (dev->discard) {
+		size = (rx_amount < dev->discard) ? rx_amount : dev->discard;
+		dev->discard -= size;
+	}
+	else if (dev->discard_line) {
+		while (size < rx_amount) {
+			if ((*_rx_char(dev, size++) & dev->mask_msb) == RX_END_CHAR) {
+				dev->discard_line = 0;
+				break;
+			}
+		}
+	}
+	if (size == 0) {
+		return rx_amount;
+	}
+	_drop_rx(dev, size);
+	return IS_RX_RING(dev) ? rx_amount - size : 0;
+}
+
+/* Uarts without a ring drop everything received by restarting */
+static void _drop_rx(uart_dev_t *dev, uint16_t size) {
+	dev->rx_last = 0;
+	if (!IS_RX_RING(dev)) {
+		_xfer_complete(dev);
+		return;
+	}
+	dev->rd = (dev->rd + size) % dev->buf_size;
+}
+
+static char *_take_cmd(uart_dev_t *dev, uint16_t size) {
+	char *tx_str = dev->tx_str;
+	uint16_t first;
+
+	/* Single buffered uarts stop receiving while the response is sent */
+	if (!IS_RX_RING(dev)) {
+		HAL_UART_AbortReceive(&dev->huart);
+		return dev->str;
+	}
+	/* The ring keeps receiving, the command is copied out of it so the next
+	 * command is received during the response */
+	first = dev->buf_size - dev->rd;
+	if (first > size) {
+		first = size;
+	}
+	memcpy(tx_str, &dev->str[dev->rd], first);
+	memcpy(&tx_str[first], dev->str, size - first);
+	memset(&tx_str[size], 0, dev->buf_size - size);
+	dev->rd = (dev->rd + size) % dev->buf_size;
+	return tx_str;
+}
+
 static error_t _tx_str(uart_dev_t *dev) {
-	char *str = dev->str;
+	char *str = dev->tx_str;
 	UART_HandleTypeDef *huart = &(dev->huart);
 	error_t err = ENXIO;
 	HAL_StatusTypeDef status = dev->tx_data_fxn(huart, (uint8_t*) str,
@@ -490,8 +738,24 @@ static inline void _update_rx_count(uart_dev_t* dev, uint16_t rx_amount) {
 	}
 }
 
+/* Any valid command shows the host switched to the new baudrate */
+static inline void _confirm_if_baud(uart_dev_t* dev, error_t err) {
+	if (err == 0 && dev->huart.Instance == IF_UART_INST) {
+		if_fallback_baud = 0;
+	}
+}
+
 static inline int32_t _get_rx_amount(uart_dev_t *dev) {
-	return (dev->buf_size - dev->huart.hdmarx->Instance->CNDTR);
+	uint32_t wr = dev->buf_size - dev->huart.hdmarx->Instance->CNDTR;
+
+	if (!IS_RX_RING(dev)) {
+		return wr;
+	}
+	return (wr + dev->buf_size - dev->rd) % dev->buf_size;
+}
+
+static inline char *_rx_char(uart_dev_t *dev, uint16_t index) {
+	return &dev->str[(dev->rd + index) % dev->buf_size];
 }
 
 /******************************************************************************/
@@ -519,6 +783,15 @@ void IF_UART_DMA_RX_INT(void) {
 	HAL_DMA_IRQHandler(&hdma_usart_if_rx);
 }
 
+#ifdef IF_UART_DMA_TX_INST
+/**
+ * @brief This function handles if_dma_tx event interrupt.
+ */
+void IF_UART_DMA_TX_INT(void) {
+	HAL_DMA_IRQHandler(&hdma_usart_if_tx);
+}
+#endif
+
 /**
  * @brief This function handles dut_uart event interrupt.
  */
@@ -534,6 +807,7 @@ void DUT_UART_INT(void) {
 	} else if (dut_uart.huart.ErrorCode & HAL_UART_ERROR_ORE) {
 		dut_uart_reg->status.ore = 1;
 	}
+	REG_SNAP_CHANGED(REG_SNAP_UART);
 }
 
 /**
@@ -548,4 +822,5 @@ void IF_UART_INT(void) {
  */
 void GPIO_CTS_INT() {
 	dut_uart_reg->status.cts = 1;
+	REG_SNAP_CHANGED(REG_SNAP_UART);
 }
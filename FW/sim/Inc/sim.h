@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup sim
+ * @{
+ * @file			sim.h
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Host simulation of the PHiLIP hardware.
+ * @details			The peripheral registers are plain memory at their
+ * 					hardware addresses so the application code runs
+ * 					unchanged. The HAL functions used by the simulated
+ * 					modules are replaced, the uarts are exposed as
+ * 					pseudoterminals and transfers take as long as they would
+ * 					at the configured baudrate.
+ ******************************************************************************
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+/* Defines ********************************************************************/
+/** @brief	Environment variable with the uart file descriptors after reset */
+#define SIM_FDS_ENV			"PHILIP_SIM_FDS"
+
+/** @brief	Longest time the simulation sleeps when idle in ns */
+#define SIM_IDLE_NS			(1000000)
+
+/** @brief	Time between polling the pseudoterminals when busy in ns */
+#define SIM_PUMP_NS			(10000)
+
+/* Enums **********************************************************************/
+/** @brief	The simulated uarts */
+enum SIM_UART {
+	SIM_UART_IF, /**< Interface uart, used by philip_pal */
+	SIM_UART_DUT, /**< DUT uart */
+	SIM_UART_NUMOF /**< Amount of simulated uarts */
+};
+
+/* Function prototypes ********************************************************/
+/**
+ * @brief		Opens the pseudoterminals of the uarts.
+ *
+ * @param[in]	argv		Arguments to restart the simulation with
+ * @param[in]	links		Symlinks to create for each uart, NULL for none
+ * @param[in]	paced		0 to transfer data as fast as possible
+ *
+ * @return		0 on success
+ * @return		errno of the failing call
+ *
+ * @note		After sim_reset() the pseudoterminals are inherited.
+ */
+int sim_init(char **argv, const char *const *links, uint8_t paced);
+
+/**
+ * @brief		Gets the name of a uart pseudoterminal.
+ *
+ * @param[in]	uart		The SIM_UART
+ *
+ * @return		The path of the pseudoterminal to connect to
+ */
+const char *sim_uart_name(uint8_t uart);
+
+/**
+ * @brief		Moves data between the uarts and the pseudoterminals.
+ *
+ * @note		Called from HAL_GetTick(), at most every SIM_PUMP_NS.
+ */
+void sim_pump(void);
+
+/**
+ * @brief		Waits for a uart event or at most SIM_IDLE_NS.
+ *
+ * @note		Keeps the simulation from spinning a host core, called by
+ * 				the watchdog task.
+ */
+void sim_idle(void);
+
+#endif /* SIM_H_ */
+/** @} */
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup sim
+ * @{
+ * @file			sim_cmsis.h
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Host replacement for the gcc specific CMSIS header.
+ * @details			Included before every source of the simulation so the
+ * 					Cortex-M instructions of cmsis_gcc.h are never compiled.
+ * 					There are no interrupts on the host so masking them only
+ * 					keeps the PRIMASK value.
+ ******************************************************************************
+ */
+
+#ifndef SIM_CMSIS_H_
+#define SIM_CMSIS_H_
+
+/* Includes *******************************************************************/
+#include <stdint.h>
+
+/* Defines ********************************************************************/
+/* Keeps cmsis_gcc.h from being included */
+#define __CMSIS_GCC_H
+
+#define __ASM						__asm
+#define __INLINE					inline
+#define __STATIC_INLINE				static inline
+#define __STATIC_FORCEINLINE		__attribute__((always_inline)) static inline
+#define __NO_RETURN					__attribute__((__noreturn__))
+#define __USED						__attribute__((used))
+#define __WEAK						__attribute__((weak))
+#define __PACKED					__attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT				struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION				union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)				__attribute__((aligned(x)))
+#define __RESTRICT					__restrict
+
+/* Routes NVIC_SystemReset() to the simulation */
+#define CMSIS_NVIC_VIRTUAL
+#define CMSIS_NVIC_VIRTUAL_HEADER_FILE	"sim_nvic.h"
+
+/* Variables ******************************************************************/
+/** @brief	PRIMASK of the simulated core */
+extern uint32_t sim_primask;
+
+/* Function prototypes ********************************************************/
+static inline void __enable_irq(void) {
+	sim_primask = 0;
+}
+
+static inline void __disable_irq(void) {
+	sim_primask = 1;
+}
+
+static inline uint32_t __get_PRIMASK(void) {
+	return sim_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask) {
+	sim_primask = primask;
+}
+
+static inline void __NOP(void) {
+}
+
+static inline void __ISB(void) {
+	__sync_synchronize();
+}
+
+static inline void __DSB(void) {
+	__sync_synchronize();
+}
+
+static inline void __DMB(void) {
+	__sync_synchronize();
+}
+
+static inline uint32_t __REV(uint32_t value) {
+	return __builtin_bswap32(value);
+}
+
+static inline uint32_t __REV16(uint32_t value) {
+	return ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);
+}
+
+static inline uint32_t __RBIT(uint32_t value) {
+	uint32_t result = 0;
+
+	for (int i = 0; i < 32; i++) {
+		result = (result << 1) | ((value >> i) & 1);
+	}
+	return result;
+}
+
+static inline uint8_t __CLZ(uint32_t value) {
+	return value ? __builtin_clz(value) : 32;
+}
+
+#endif /* SIM_CMSIS_H_ */
+/** @} */
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup sim
+ * @{
+ * @file			sim_nvic.h
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			NVIC functions of the simulation.
+ * @details			Included by core_cm3.h through CMSIS_NVIC_VIRTUAL, only
+ * 					the system reset differs from the CMSIS functions.
+ ******************************************************************************
+ */
+
+#ifndef SIM_NVIC_H_
+#define SIM_NVIC_H_
+
+/* Defines ********************************************************************/
+#define NVIC_SetPriorityGrouping	__NVIC_SetPriorityGrouping
+#define NVIC_GetPriorityGrouping	__NVIC_GetPriorityGrouping
+#define NVIC_EnableIRQ				__NVIC_EnableIRQ
+#define NVIC_GetEnableIRQ			__NVIC_GetEnableIRQ
+#define NVIC_DisableIRQ				__NVIC_DisableIRQ
+#define NVIC_GetPendingIRQ			__NVIC_GetPendingIRQ
+#define NVIC_SetPendingIRQ			__NVIC_SetPendingIRQ
+#define NVIC_ClearPendingIRQ		__NVIC_ClearPendingIRQ
+#define NVIC_GetActive				__NVIC_GetActive
+#define NVIC_SetPriority			__NVIC_SetPriority
+#define NVIC_GetPriority			__NVIC_GetPriority
+#define NVIC_SystemReset			sim_reset
+
+/* Function prototypes ********************************************************/
+/**
+ * @brief		Restarts the simulation with the same uarts.
+ */
+__NO_RETURN void sim_reset(void);
+
+#endif /* SIM_NVIC_H_ */
+/** @} */
@@ -0,0 +1,682 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup sim
+ * @{
+ * @file			sim_hal.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Simulated HAL for running the application on a host.
+ * @details			Only the HAL functions used by the simulated modules are
+ * 					implemented. Register accesses of the application go to
+ * 					memory mapped at the peripheral addresses. The SysTick
+ * 					and HAL tick follow the host monotonic clock.
+ * @}
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <termios.h>
+/* Names of termios flags that are also register names */
+#undef CR1
+#undef CR2
+#undef CR3
+
+#include "stm32f1xx_hal.h"
+
+#include "port.h"
+
+#include "sim.h"
+
+/* Private defines ************************************************************/
+/** @brief	Bits of a uart frame with start and stop bit */
+#define UART_FRAME_BITS		(10)
+
+/** @brief	Size of the receive fifo between the pseudoterminal and dma */
+#define RX_FIFO_SIZE		(256)
+
+/** @brief	The reset value of the simulated system clock */
+#define SIM_CORE_CLOCK		(72000000)
+
+/* Private enums/structs ******************************************************/
+/** @brief	A simulated uart connected to a pseudoterminal */
+typedef struct {
+	USART_TypeDef *inst; /**< The uart instance */
+	UART_HandleTypeDef *huart; /**< Handle of the last init */
+	int fd; /**< Master side of the pseudoterminal */
+	uint8_t fifo[RX_FIFO_SIZE]; /**< Bytes read but not yet received */
+	uint16_t fifo_index; /**< Next byte in the fifo */
+	uint16_t fifo_len; /**< Amount of bytes in the fifo */
+	uint64_t rx_ns; /**< Time the next byte is received, 0 if idle */
+	uint64_t tx_ns; /**< Time the transmission started */
+	const uint8_t *tx_data; /**< Data being transmitted */
+	uint16_t tx_size; /**< Amount of data to transmit */
+	uint16_t tx_sent; /**< Amount of data written to the pseudoterminal */
+	uint8_t tx_blocked; /**< The pseudoterminal buffer is full */
+	uint8_t hung; /**< The host closed the pseudoterminal */
+} sim_uart_t;
+
+/** @brief	A region of registers mapped as memory */
+typedef struct {
+	uintptr_t base; /**< Start address */
+	size_t size; /**< Size in bytes */
+} sim_region_t;
+
+/* Private function prototypes ************************************************/
+static uint64_t _now_ns();
+static uint64_t _byte_ns(sim_uart_t *uart);
+static sim_uart_t *_get_uart(USART_TypeDef *inst);
+static int _open_pty(sim_uart_t *uart);
+static void _pump_rx(sim_uart_t *uart, uint64_t now);
+static void _pump_tx(sim_uart_t *uart, uint64_t now);
+static int64_t _next_event_ns(sim_uart_t *uart, uint64_t now);
+static HAL_StatusTypeDef _transmit(UART_HandleTypeDef *huart, uint8_t *data,
+		uint16_t size);
+
+/* Variables ******************************************************************/
+uint32_t sim_primask = 0;
+
+uint32_t SystemCoreClock = SIM_CORE_CLOCK;
+
+/* Private variables **********************************************************/
+/** @brief	Peripheral and core peripheral register space */
+static const sim_region_t regions[] = {
+	{.base = PERIPH_BASE, .size = 0x30000},
+	{.base = 0xE0000000, .size = 0x100000},
+};
+
+static sim_uart_t uarts[SIM_UART_NUMOF] = {
+	[SIM_UART_IF] = {.inst = IF_UART_INST, .fd = -1},
+	[SIM_UART_DUT] = {.inst = DUT_UART_INST, .fd = -1},
+};
+
+static char sim_exe[PATH_MAX];
+static char **sim_argv;
+static uint8_t sim_paced = 1;
+static uint64_t start_ns;
+static uint64_t pump_ns;
+
+/******************************************************************************/
+/*           Initialization                                                   */
+/******************************************************************************/
+/* Runs before any code touches a register */
+__attribute__((constructor)) static void _map_regions() {
+	for (size_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+		void *addr = mmap((void*)regions[i].base, regions[i].size,
+				PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+		if (addr != (void*)regions[i].base) {
+			fprintf(stderr, "Cannot map registers at 0x%08lx\n",
+					(unsigned long)regions[i].base);
+			exit(EXIT_FAILURE);
+		}
+	}
+	start_ns = _now_ns();
+}
+
+int sim_init(char **argv, const char *const *links, uint8_t paced) {
+	char *fds = getenv(SIM_FDS_ENV);
+
+	sim_argv = argv;
+	sim_paced = paced;
+	/* Keeps the process name after a reset */
+	if (realpath("/proc/self/exe", sim_exe) == NULL) {
+		return errno;
+	}
+	if (fds != NULL) {
+		/* Restarted by sim_reset(), the host stays connected */
+		for (int i = 0; i < SIM_UART_NUMOF; i++) {
+			uarts[i].fd = strtol(fds, &fds, 10);
+			fds += (*fds == ',');
+		}
+		unsetenv(SIM_FDS_ENV);
+		return 0;
+	}
+	for (int i = 0; i < SIM_UART_NUMOF; i++) {
+		if (_open_pty(&uarts[i]) != 0) {
+			return errno;
+		}
+		if (links != NULL && links[i] != NULL) {
+			unlink(links[i]);
+			if (symlink(ptsname(uarts[i].fd), links[i]) != 0) {
+				return errno;
+			}
+		}
+	}
+	return 0;
+}
+
+static int _open_pty(sim_uart_t *uart) {
+	struct termios tio;
+
+	uart->fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (uart->fd < 0 || grantpt(uart->fd) != 0 || unlockpt(uart->fd) != 0) {
+		return -1;
+	}
+	/* No echo or line editing before the host configures the terminal */
+	if (tcgetattr(uart->fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		tcsetattr(uart->fd, TCSANOW, &tio);
+	}
+	return 0;
+}
+
+const char *sim_uart_name(uint8_t uart) {
+	return ptsname(uarts[uart].fd);
+}
+
+void sim_reset(void) {
+	char fds[32];
+
+	snprintf(fds, sizeof(fds), "%d,%d", uarts[SIM_UART_IF].fd,
+			uarts[SIM_UART_DUT].fd);
+	setenv(SIM_FDS_ENV, fds, 1);
+	execv(sim_exe, sim_argv);
+	perror("Cannot reset");
+	exit(EXIT_FAILURE);
+}
+
+/******************************************************************************/
+/*           Simulation                                                       */
+/******************************************************************************/
+static uint64_t _now_ns() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec - start_ns;
+}
+
+static uint64_t _byte_ns(sim_uart_t *uart) {
+	if (!sim_paced || uart->huart == NULL) {
+		return 0;
+	}
+	return 1000000000ULL * UART_FRAME_BITS / uart->huart->Init.BaudRate;
+}
+
+static sim_uart_t *_get_uart(USART_TypeDef *inst) {
+	for (int i = 0; i < SIM_UART_NUMOF; i++) {
+		if (uarts[i].inst == inst) {
+			return &uarts[i];
+		}
+	}
+	return NULL;
+}
+
+void sim_pump(void) {
+	uint64_t now = _now_ns();
+
+	pump_ns = now;
+	for (int i = 0; i < SIM_UART_NUMOF; i++) {
+		_pump_rx(&uarts[i], now);
+		_pump_tx(&uarts[i], now);
+	}
+}
+
+void sim_idle(void) {
+	struct pollfd pfds[SIM_UART_NUMOF];
+	uint64_t now = _now_ns();
+	int64_t timeout = SIM_IDLE_NS;
+
+	for (int i = 0; i < SIM_UART_NUMOF; i++) {
+		int64_t next = _next_event_ns(&uarts[i], now);
+
+		if (next < timeout) {
+			timeout = next;
+		}
+		/* A closed pseudoterminal always reports a hangup, reconnecting is
+		 * noticed by the next read */
+		pfds[i].fd = uarts[i].hung ? -1 : uarts[i].fd;
+		pfds[i].events = (uarts[i].fifo_len ? 0 : POLLIN) |
+				(uarts[i].tx_blocked ? POLLOUT : 0);
+		pfds[i].revents = 0;
+	}
+	if (timeout > 0) {
+		struct timespec ts = {.tv_sec = 0, .tv_nsec = timeout};
+
+		ppoll(pfds, SIM_UART_NUMOF, &ts, NULL);
+	}
+	sim_pump();
+}
+
+static int64_t _next_event_ns(sim_uart_t *uart, uint64_t now) {
+	UART_HandleTypeDef *huart = uart->huart;
+	int64_t next = SIM_IDLE_NS;
+
+	if (huart == NULL) {
+		return next;
+	}
+	if (huart->gState == HAL_UART_STATE_BUSY_TX && !uart->tx_blocked) {
+		next = uart->tx_ns + (uart->tx_sent + 1) * _byte_ns(uart) - now;
+		if (next < SIM_PUMP_NS) {
+			next = SIM_PUMP_NS;
+		}
+	}
+	if (uart->fifo_len && HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAR)
+			&& (int64_t)(uart->rx_ns - now) < next) {
+		next = uart->rx_ns - now;
+	}
+	return next;
+}
+
+static void _pump_rx(sim_uart_t *uart, uint64_t now) {
+	UART_HandleTypeDef *huart = uart->huart;
+	uint64_t byte_ns = _byte_ns(uart);
+	__IO uint32_t *cndtr;
+	ssize_t len;
+
+	if (uart->fifo_len == 0) {
+		uart->fifo_index = 0;
+		len = read(uart->fd, uart->fifo, sizeof(uart->fifo));
+		uart->hung = (len < 0 && errno == EIO);
+		if (len <= 0) {
+			uart->rx_ns = 0;
+			return;
+		}
+		uart->fifo_len = len;
+		if (uart->rx_ns == 0) {
+			uart->rx_ns = now + byte_ns;
+		}
+	}
+	/* Bytes wait in the fifo while the receiver is off */
+	if (huart == NULL || huart->RxState != HAL_UART_STATE_BUSY_RX ||
+			!HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAR)) {
+		if (uart->rx_ns < now) {
+			uart->rx_ns = now;
+		}
+		return;
+	}
+	cndtr = &huart->hdmarx->Instance->CNDTR;
+	while (uart->fifo_len && *cndtr && uart->rx_ns <= now) {
+		huart->pRxBuffPtr[huart->RxXferSize - *cndtr] =
+				uart->fifo[uart->fifo_index++];
+		uart->fifo_len--;
+		(*cndtr)--;
+		uart->rx_ns += byte_ns;
+		/* A circular transfer wraps back to the start of the buffer */
+		if (*cndtr == 0 && huart->hdmarx->Init.Mode == DMA_CIRCULAR) {
+			*cndtr = huart->RxXferSize;
+		}
+	}
+	/* A full buffer completes the transfer like the dma interrupt would */
+	if (*cndtr == 0 && huart->hdmarx->Init.Mode == DMA_NORMAL) {
+		huart->Instance->CR3 &= ~USART_CR3_DMAR;
+		huart->RxState = HAL_UART_STATE_READY;
+	}
+}
+
+/* Bytes are written when they would be on the line, the host sees the last
+ * byte when the transfer completes */
+static void _pump_tx(sim_uart_t *uart, uint64_t now) {
+	UART_HandleTypeDef *huart = uart->huart;
+	uint64_t byte_ns = _byte_ns(uart);
+	uint64_t due = uart->tx_size;
+	ssize_t len;
+
+	if (huart == NULL || huart->gState != HAL_UART_STATE_BUSY_TX) {
+		return;
+	}
+	if (byte_ns && (now - uart->tx_ns) / byte_ns < due) {
+		due = (now - uart->tx_ns) / byte_ns;
+	}
+	if (due > uart->tx_sent) {
+		len = write(uart->fd, &uart->tx_data[uart->tx_sent],
+				due - uart->tx_sent);
+		uart->tx_blocked = (len < 0 && errno == EAGAIN);
+		if (len < 0 && errno != EAGAIN) {
+			/* Nobody is connected, the data is lost on the line */
+			len = due - uart->tx_sent;
+		}
+		if (len > 0) {
+			uart->tx_sent += len;
+		}
+	}
+	if (uart->tx_sent == uart->tx_size) {
+		huart->TxXferCount = 0;
+		huart->gState = HAL_UART_STATE_READY;
+	}
+}
+
+/******************************************************************************/
+/*           HAL                                                              */
+/******************************************************************************/
+HAL_StatusTypeDef HAL_Init(void) {
+	return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void) {
+	uint64_t now = _now_ns();
+	uint64_t cycles = now * (SystemCoreClock / 1000000) / 1000;
+	uint32_t reload = SysTick->LOAD + 1;
+
+	if (now - pump_ns >= SIM_PUMP_NS) {
+		sim_pump();
+	}
+	SysTick->VAL = SysTick->LOAD - (cycles % reload);
+	return cycles / reload;
+}
+
+uint32_t HAL_SYSTICK_Config(uint32_t TicksNumb) {
+	SysTick->LOAD = TicksNumb - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk |
+			SysTick_CTRL_ENABLE_Msk;
+	return 0;
+}
+
+uint32_t HAL_RCC_GetSysClockFreq(void) {
+	return SystemCoreClock;
+}
+
+uint32_t HAL_GetUIDw0(void) {
+	return 0x5053494D;
+}
+
+uint32_t HAL_GetUIDw1(void) {
+	return 0x494C4948;
+}
+
+uint32_t HAL_GetUIDw2(void) {
+	return 0x00000000;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority,
+		uint32_t SubPriority) {
+	NVIC_SetPriority(IRQn, PreemptPriority);
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) {
+	NVIC_EnableIRQ(IRQn);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) {
+	NVIC_DisableIRQ(IRQn);
+}
+
+/******************************************************************************/
+/* Unconnected inputs follow the pull, outputs read back their level and
+ * peripheral outputs idle high like a uart */
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+	uint32_t pin = GPIO_Init->Pin;
+
+	if (GPIO_Init->Mode == GPIO_MODE_OUTPUT_PP ||
+			GPIO_Init->Mode == GPIO_MODE_OUTPUT_OD) {
+		GPIOx->IDR = (GPIOx->IDR & ~pin) | (GPIOx->ODR & pin);
+	} else if (GPIO_Init->Mode == GPIO_MODE_AF_PP ||
+			GPIO_Init->Mode == GPIO_MODE_AF_OD) {
+		GPIOx->IDR |= pin;
+	} else if (GPIO_Init->Pull == GPIO_PULLUP) {
+		GPIOx->IDR |= pin;
+	} else if (GPIO_Init->Pull == GPIO_PULLDOWN) {
+		GPIOx->IDR &= ~pin;
+	}
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin) {
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+		GPIO_PinState PinState) {
+	if (PinState != GPIO_PIN_RESET) {
+		GPIOx->ODR |= GPIO_Pin;
+		GPIOx->IDR |= GPIO_Pin;
+	} else {
+		GPIOx->ODR &= ~GPIO_Pin;
+		GPIOx->IDR &= ~GPIO_Pin;
+	}
+}
+
+/******************************************************************************/
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma) {
+	hdma->State = HAL_DMA_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma) {
+	hdma->State = HAL_DMA_STATE_RESET;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma,
+		uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength) {
+	hdma->Instance->CNDTR = DataLength;
+	hdma->State = HAL_DMA_STATE_BUSY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma,
+		uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength) {
+	hdma->Instance->CNDTR = DataLength;
+	hdma->State = HAL_DMA_STATE_BUSY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma) {
+	hdma->State = HAL_DMA_STATE_READY;
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma) {
+}
+
+/******************************************************************************/
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart) {
+	sim_uart_t *uart = _get_uart(huart->Instance);
+
+	if (uart == NULL) {
+		return HAL_ERROR;
+	}
+	if (huart->gState == HAL_UART_STATE_RESET) {
+		huart->Lock = HAL_UNLOCKED;
+		HAL_UART_MspInit(huart);
+	}
+	uart->huart = huart;
+	huart->Instance->CR1 |= USART_CR1_UE;
+	huart->ErrorCode = HAL_UART_ERROR_NONE;
+	huart->gState = HAL_UART_STATE_READY;
+	huart->RxState = HAL_UART_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart) {
+	sim_uart_t *uart = _get_uart(huart->Instance);
+
+	HAL_UART_Abort(huart);
+	HAL_UART_MspDeInit(huart);
+	huart->Instance->CR1 &= ~USART_CR1_UE;
+	huart->gState = HAL_UART_STATE_RESET;
+	huart->RxState = HAL_UART_STATE_RESET;
+	if (uart != NULL) {
+		uart->huart = NULL;
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart,
+		uint8_t *pData, uint16_t Size) {
+	return _transmit(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart,
+		uint8_t *pData, uint16_t Size) {
+	return _transmit(huart, pData, Size);
+}
+
+static HAL_StatusTypeDef _transmit(UART_HandleTypeDef *huart, uint8_t *data,
+		uint16_t size) {
+	sim_uart_t *uart = _get_uart(huart->Instance);
+
+	if (huart->gState != HAL_UART_STATE_READY) {
+		return HAL_BUSY;
+	}
+	if (data == NULL || size == 0 || uart == NULL) {
+		return HAL_ERROR;
+	}
+	huart->pTxBuffPtr = data;
+	huart->TxXferSize = size;
+	huart->TxXferCount = size;
+	huart->gState = HAL_UART_STATE_BUSY_TX;
+	uart->tx_data = data;
+	uart->tx_size = size;
+	uart->tx_sent = 0;
+	uart->tx_ns = _now_ns();
+	_pump_tx(uart, uart->tx_ns);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart,
+		uint8_t *pData, uint16_t Size) {
+	if (huart->RxState != HAL_UART_STATE_READY) {
+		return HAL_BUSY;
+	}
+	if (pData == NULL || Size == 0) {
+		return HAL_ERROR;
+	}
+	huart->pRxBuffPtr = pData;
+	huart->RxXferSize = Size;
+	huart->RxState = HAL_UART_STATE_BUSY_RX;
+	huart->hdmarx->Instance->CNDTR = Size;
+	huart->Instance->CR3 |= USART_CR3_DMAR;
+	return HAL_OK;
+}
+
+/* The remaining count stays in the dma like on hardware */
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart) {
+	huart->Instance->CR3 &= ~USART_CR3_DMAR;
+	huart->RxXferCount = 0;
+	huart->RxState = HAL_UART_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart) {
+	sim_uart_t *uart = _get_uart(huart->Instance);
+
+	if (uart != NULL) {
+		uart->tx_size = 0;
+		uart->tx_sent = 0;
+	}
+	huart->Instance->CR3 &= ~(USART_CR3_DMAR | USART_CR3_DMAT);
+	huart->TxXferCount = 0;
+	huart->RxXferCount = 0;
+	huart->ErrorCode = HAL_UART_ERROR_NONE;
+	huart->gState = HAL_UART_STATE_READY;
+	huart->RxState = HAL_UART_STATE_READY;
+	return HAL_OK;
+}
+
+void HAL_UART_IRQHandler(UART_HandleTypeDef *huart) {
+}
+
+/******************************************************************************/
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim) {
+	if (htim->State == HAL_TIM_STATE_RESET) {
+		htim->Lock = HAL_UNLOCKED;
+		HAL_TIM_Base_MspInit(htim);
+	}
+	htim->Instance->ARR = htim->Init.Period;
+	htim->Instance->PSC = htim->Init.Prescaler;
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_DeInit(TIM_HandleTypeDef *htim) {
+	HAL_TIM_Base_MspDeInit(htim);
+	htim->State = HAL_TIM_STATE_RESET;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim) {
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim) {
+	htim->Instance->CR1 &= ~TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim,
+		TIM_ClockConfigTypeDef *sClockSourceConfig) {
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Init(TIM_HandleTypeDef *htim) {
+	if (htim->State == HAL_TIM_STATE_RESET) {
+		htim->Lock = HAL_UNLOCKED;
+		HAL_TIM_IC_MspInit(htim);
+	}
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_ConfigChannel(TIM_HandleTypeDef *htim,
+		TIM_IC_InitTypeDef *sConfig, uint32_t Channel) {
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim,
+		TIM_OC_InitTypeDef *sConfig, uint32_t Channel) {
+	return HAL_OK;
+}
+
+/* No edges are captured so the dma never advances */
+HAL_StatusTypeDef HAL_TIM_IC_Start_DMA(TIM_HandleTypeDef *htim,
+		uint32_t Channel, uint32_t *pData, uint16_t Length) {
+	DMA_HandleTypeDef *hdma = htim->hdma[TIM_DMA_ID_CC1 + Channel / 4];
+
+	if (hdma == NULL) {
+		return HAL_ERROR;
+	}
+	hdma->Instance->CNDTR = Length;
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Stop_DMA(TIM_HandleTypeDef *htim,
+		uint32_t Channel) {
+	htim->Instance->CR1 &= ~TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim,
+		uint32_t Channel) {
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Stop(TIM_HandleTypeDef *htim,
+		uint32_t Channel) {
+	htim->Instance->CR1 &= ~TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_SlaveConfigSynchro(TIM_HandleTypeDef *htim,
+		TIM_SlaveConfigTypeDef *sSlaveConfig) {
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(
+		TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig) {
+	return HAL_OK;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup sim
+ * @{
+ * @file			sim_main.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Entry point of the host simulation.
+ * @details			Opens the uart pseudoterminals and runs the application
+ * 					main, which is renamed to app_main for the simulation.
+ *
+ * 					Usage: PHiLIP_sim [-i IF_LINK] [-d DUT_LINK] [-u]
+ * 					-i and -d create symlinks to the pseudoterminals, -u
+ * 					transfers uart data without waiting for the baudrate.
+ * @}
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+/* Function prototypes ********************************************************/
+int app_main(void);
+
+/******************************************************************************/
+/*           Functions                                                        */
+/******************************************************************************/
+int main(int argc, char **argv) {
+	const char *links[SIM_UART_NUMOF] = {NULL};
+	uint8_t paced = 1;
+	int restarted = getenv(SIM_FDS_ENV) != NULL;
+	int opt;
+	int err;
+
+	while ((opt = getopt(argc, argv, "i:d:u")) != -1) {
+		if (opt == 'i') {
+			links[SIM_UART_IF] = optarg;
+		} else if (opt == 'd') {
+			links[SIM_UART_DUT] = optarg;
+		} else if (opt == 'u') {
+			paced = 0;
+		} else {
+			fprintf(stderr, "Usage: %s [-i IF_LINK] [-d DUT_LINK] [-u]\n",
+					argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	err = sim_init(argv, links, paced);
+	if (err != 0) {
+		fprintf(stderr, "Cannot open uarts: %s\n", strerror(err));
+		return EXIT_FAILURE;
+	}
+	if (!restarted) {
+		printf("if_uart: %s\n", sim_uart_name(SIM_UART_IF));
+		printf("dut_uart: %s\n", sim_uart_name(SIM_UART_DUT));
+		fflush(stdout);
+	}
+	return app_main();
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @addtogroup sim
+ * @{
+ * @file			sim_periph.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Peripherals without a simulation and the port layer.
+ * @details			Commits of the peripherals that are not simulated succeed
+ * 					without changing anything so the registers keep their
+ * 					defaults.
+ * @}
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "stm32f1xx_hal.h"
+
+#include "mm_typedefs.h"
+#include "app_common.h"
+#include "i2c.h"
+#include "spi.h"
+#include "adc.h"
+#include "rtc.h"
+#include "pwm_dac.h"
+#include "led_flash.h"
+#include "wdt.h"
+#include "tmr.h"
+#include "uart.h"
+#include "port.h"
+
+#include "sim.h"
+
+/******************************************************************************/
+/*           Port                                                             */
+/******************************************************************************/
+void init_clock(void) {
+	SystemCoreClock = 72000000;
+	HAL_SYSTICK_Config((1UL) << TICK_BIT_OFFSET);
+}
+
+void init_periphs(void) {
+}
+
+void _Error_Handler(char *file, int line) {
+	fprintf(stderr, "Error at %s:%d\n", file, line);
+	abort();
+}
+
+void HAL_UART_MspInit(UART_HandleTypeDef* huart) {
+	if (huart->Instance == IF_UART_INST) {
+		init_if_uart_msp();
+	}
+	else if (huart->Instance == DUT_UART_INST) {
+		init_dut_uart_msp();
+	}
+}
+
+void HAL_UART_MspDeInit(UART_HandleTypeDef* huart) {
+	if (huart->Instance == IF_UART_INST) {
+		deinit_if_uart_msp();
+	}
+	else if (huart->Instance == DUT_UART_INST) {
+		deinit_dut_uart_msp();
+	}
+}
+
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base) {
+	if (htim_base->Instance == DUT_IC_INST) {
+		init_dut_ic_msp();
+	}
+}
+
+void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef* htim_base) {
+	if (htim_base->Instance == DUT_IC_INST) {
+		deinit_dut_ic_msp();
+	}
+}
+
+void HAL_TIM_IC_MspInit(TIM_HandleTypeDef* htim) {
+	if (htim->Instance == DUT_IC_INST) {
+		init_dut_ic_msp();
+	}
+}
+
+/******************************************************************************/
+/*           Watchdog and LED                                                 */
+/******************************************************************************/
+void init_wdt() {
+}
+
+/* The only task that runs every tick, the simulation sleeps here */
+void reset_wdt() {
+	sim_idle();
+}
+
+void init_led_flash() {
+}
+
+void flash_fw_version() {
+}
+
+/******************************************************************************/
+/*           I2C                                                              */
+/******************************************************************************/
+void init_dut_i2c(map_t *reg) {
+}
+
+error_t commit_dut_i2c() {
+	return 0;
+}
+
+void update_dut_i2c_inputs() {
+}
+
+/******************************************************************************/
+/*           SPI                                                              */
+/******************************************************************************/
+void init_dut_spi(map_t *reg) {
+}
+
+error_t commit_dut_spi() {
+	return 0;
+}
+
+void update_dut_spi_inputs() {
+}
+
+void poll_dut_spi_ic() {
+}
+
+uint8_t get_dut_spi_ic_fill() {
+	return 0;
+}
+
+void GPIO_NSS_INT() {
+}
+
+error_t drain_dut_spi_sniff(uint16_t ack, uint8_t *buf, uint16_t max_size,
+		uint16_t *size, uint16_t *pos, uint16_t *pending) {
+	if (ack != 0) {
+		return ERANGE;
+	}
+	*size = 0;
+	*pos = 0;
+	*pending = 0;
+	return 0;
+}
+
+/******************************************************************************/
+/*           ADC                                                              */
+/******************************************************************************/
+void init_dut_adc(map_t *reg) {
+}
+
+error_t commit_dut_adc() {
+	return 0;
+}
+
+void poll_dut_adc() {
+}
+
+/******************************************************************************/
+/*           RTC                                                              */
+/******************************************************************************/
+void init_rtc(map_t *reg) {
+}
+
+error_t commit_rtc() {
+	return 0;
+}
+
+void update_rtc() {
+}
+
+/******************************************************************************/
+/*           PWM and DAC                                                      */
+/******************************************************************************/
+void init_dut_pwm_dac(map_t *reg) {
+}
+
+error_t commit_dut_pwm() {
+	return 0;
+}
+
+error_t commit_dut_dac() {
+	return 0;
+}
+
+void update_dut_pwm_inputs() {
+}
+
+void update_dut_dac_inputs() {
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @file			test_prof.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Host unit test of the profile aggregation.
+ * @details			Calls are timed with a stubbed cycle counter that each
+ * 					call advances by a known amount.
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include "stm32f1xx_hal.h"
+
+#include "mm_typedefs.h"
+#include "app_reg.h"
+
+/** @brief	Stubbed cycle counter */
+static uint32_t stub_cycles;
+
+#undef PROF_CYCLES
+/** @brief	Reads the stubbed cycle counter */
+#define PROF_CYCLES()	(stub_cycles)
+
+#include "prof.h"
+
+/* Private macros *************************************************************/
+/** @brief	Counts a failed check and prints where it is */
+#define CHECK(x)	do { if (!(x)) { printf("%s:%d: %s\n", __FILE__, \
+		__LINE__, #x); failed++; } } while (0)
+
+/* Global variables ***********************************************************/
+volatile uint32_t reg_snap_seq[REG_SNAP_NUMOF];
+
+/* Private variables **********************************************************/
+static int failed = 0;
+
+/******************************************************************************/
+/* Times a call that takes the given cycles like PROF_START() and PROF_END() */
+static void _profiled_call(prof_entry_t *entry, uint32_t cycles) {
+	uint32_t start = PROF_CYCLES();
+
+	stub_cycles += cycles;
+	update_prof_entry(entry, PROF_CYCLES() - start);
+}
+
+static void _test_aggregation() {
+	prof_entry_t entry = {0};
+
+	_profiled_call(&entry, 100);
+	_profiled_call(&entry, 40);
+	_profiled_call(&entry, 250);
+	CHECK(entry.call_count == 3);
+	CHECK(entry.min_cycles == 40);
+	CHECK(entry.max_cycles == 250);
+	CHECK(entry.total_cycles == 390);
+	CHECK(entry.mean_cycles == 130);
+}
+
+static void _test_counter_wrap() {
+	prof_entry_t entry = {0};
+
+	stub_cycles = UINT32_MAX - 10;
+	_profiled_call(&entry, 30);
+	CHECK(entry.min_cycles == 30);
+	CHECK(entry.max_cycles == 30);
+	CHECK(entry.total_cycles == 30);
+}
+
+static void _test_total_beyond_32_bit() {
+	prof_entry_t entry = {0};
+
+	_profiled_call(&entry, UINT32_MAX);
+	_profiled_call(&entry, UINT32_MAX);
+	CHECK(entry.total_cycles == 2 * (uint64_t)UINT32_MAX);
+	CHECK(entry.mean_cycles == UINT32_MAX);
+}
+
+/* Writing 0 to the call count register restarts the entry */
+static void _test_restart() {
+	prof_entry_t entry = {0};
+
+	_profiled_call(&entry, 5);
+	_profiled_call(&entry, 500);
+	entry.call_count = 0;
+	_profiled_call(&entry, 50);
+	CHECK(entry.call_count == 1);
+	CHECK(entry.min_cycles == 50);
+	CHECK(entry.max_cycles == 50);
+	CHECK(entry.total_cycles == 50);
+	CHECK(entry.mean_cycles == 50);
+}
+
+/******************************************************************************/
+int main(void) {
+	_test_aggregation();
+	_test_counter_wrap();
+	_test_total_beyond_32_bit();
+	_test_restart();
+	printf("test_prof: %s\n", failed ? "FAILED" : "passed");
+	return failed != 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2020 Kevin Weiss for HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the MIT License. See the
+ * file LICENSE in the top level directory for more details.
+ * SPDX-License-Identifier:    MIT
+ */
+
+/**
+ ******************************************************************************
+ * @file			test_write_map.c
+ * @author			Kevin Weiss
+ * @date			18.10.2026
+ * @brief			Host unit test of the generated write bitmaps.
+ * @details			The bitmaps are generated from the access table, a map
+ * 					change without running generate_write_map.py fails here.
+ ******************************************************************************
+ */
+
+/* Includes *******************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+
+#include "mm_typedefs.h"
+#include "mm_access.h"
+#include "mm_write_map_philip_map.h"
+
+/* Private macros *************************************************************/
+/** @brief	Counts a failed check and prints where it is */
+#define CHECK(x)	do { if (!(x)) { printf("%s:%d: %s\n", __FILE__, \
+		__LINE__, #x); failed++; } } while (0)
+
+/* Private variables **********************************************************/
+static int failed = 0;
+
+/******************************************************************************/
+static void _test_size() {
+	CHECK(MM_WRITE_MAP_PHILIP_MAP_SIZE == sizeof(map_t));
+	CHECK(MM_WRITE_MAP_PHILIP_MAP_WORDS * 32 >= sizeof(map_t));
+}
+
+/* Each bit must match the write permission of its byte in the access table */
+static void _test_permissions() {
+	for (uint32_t i = 0; i < sizeof(map_t); i++) {
+		uint8_t permission = mm_access_philip_map(i).write_permission;
+
+		for (uint8_t level = 0; level < MM_WRITE_MAP_PHILIP_MAP_LEVELS;
+				level++) {
+			uint32_t bit = (mm_write_map_philip_map[level][i / 32] >> (i % 32))
+					& 1;
+
+			if (bit != ((permission >> level) & 1)) {
+				printf("byte %u level %u\n", i, level);
+				failed++;
+			}
+		}
+	}
+}
+
+/* The padding bits after the last byte are never writable */
+static void _test_padding() {
+	for (uint32_t i = sizeof(map_t); i < MM_WRITE_MAP_PHILIP_MAP_WORDS * 32;
+			i++) {
+		for (uint8_t level = 0; level < MM_WRITE_MAP_PHILIP_MAP_LEVELS;
+				level++) {
+			CHECK(!(mm_write_map_philip_map[level][i / 32] & (1UL << (i % 32))));
+		}
+	}
+}
+
+/******************************************************************************/
+int main(void) {
+	_test_size();
+	_test_permissions();
+	_test_padding();
+	printf("test_write_map: %s\n", failed ? "FAILED" : "passed");
+	return failed != 0;
+}
@@ -53,13 +53,52 @@ class BaseDevice:
             return self._driver.readline()
         return self._driver.readline(float(timeout))
 
-    def writeline(self, line):
+    def writeline(self, line, flush_input=True):
         """Writes data to the driver.
 
         Args:
             line(str): Variable length argument list.
+            flush_input(bool): Discard unread input before writing.
         """
-        return self._driver.writeline(line)
+        return self._driver.writeline(line, flush_input)
+
+    def read(self, size, timeout=None):
+        """Reads raw bytes from the driver.
+
+        Args:
+            size(int): Amount of bytes to read
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            bytes: data if success, driver defined error if failed.
+        """
+        if timeout is None:
+            return self._driver.read(size)
+        return self._driver.read(size, float(timeout))
+
+    def write(self, data, flush_input=True):
+        """Writes raw bytes to the driver.
+
+        Args:
+            data(bytes): Data to write.
+            flush_input(bool): Discard unread input before writing.
+        """
+        return self._driver.write(data, flush_input)
+
+    def get_baudrate(self):
+        """Gets the baudrate of the driver.
+
+        Returns:
+            int: The baudrate
+        """
+        return self._driver.get_baudrate()
+
+    def set_baudrate(self, baudrate):
+        """Changes the baudrate of the driver.
+
+        Args:
+            baudrate(int): The new baudrate
+        """
+        return self._driver.set_baudrate(baudrate)
 
     @staticmethod
     def _driver_from_config(*args, **kwargs):
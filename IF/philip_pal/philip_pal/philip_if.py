@@ -12,8 +12,10 @@ import errno
 import os
 import json
 import csv
+import struct
 import time
 from ctypes import c_uint8, c_uint16, c_uint32, c_int8, c_int16, c_int32
+from ctypes import c_int64
 from ast import literal_eval
 from pathlib import Path
 from .base_device import BaseDevice
@@ -24,14 +26,51 @@ class PhilipBaseIf():
     """Handles basic functions and commands for memory map interface
 
     Args:
+        use_binary - keyword arg that uses the binary framed protocol for
+                     reading and writing bytes instead of the ASCII shell
         (*args, **kwargs) -> See base_device for documentation of args
     """
     RESULT_SUCCESS = 'Success'
     RESULT_ERROR = 'Error'
     RESULT_TIMEOUT = 'Timeout'
 
+    BIN_SOF = 0xA5
+    BIN_HDR_SIZE = 4
+    BIN_CRC_SIZE = 2
+    BIN_CMD_READ_REG = 0x01
+    BIN_CMD_WRITE_REG = 0x02
+    BIN_CMD_EXECUTE = 0x03
+    BIN_CMD_DUMP_TRACE = 0x04
+    BIN_CMD_READ_REGS = 0x05
+    BIN_CMD_DRAIN_TRACE = 0x06
+    BIN_CMD_DRAIN_SPI_SNIFF = 0x07
+    TRACE_RECORD = struct.Struct('<BBHQI')
+    SPI_SNIFF_HDR = struct.Struct('<QIHHH')
+    SPI_SNIFF_FLAG_OVERFLOW = 0x01
+    SPI_SNIFF_FLAG_MOSI_LOST = 0x02
+    SPI_SNIFF_FLAG_MISO_LOST = 0x04
+    SPI_SNIFF_FLAG_CUT = 0x08
+    # Bytes of pipelined commands in flight, less than the device rx buffer
+    PIPELINE_BYTES = 512
+    # Limits of a single scatter-gather read given by the device buffer
+    READ_REGS_MAX_SPANS = 32
+    READ_REGS_MAX_SIZE = 249
+    BIN_READ_REGS_MAX_SIZE = 1015
+    # Time the device waits for a command at a new baudrate before falling
+    # back to the previous one
+    IF_BAUD_TIMEOUT = 1.0
+    # Interface baudrate the device starts with, DEFAULT_UART_BAUDRATE of the
+    # firmware
+    IF_BOOT_BAUDRATE = 115200
+
     def __init__(self, *args, **kwargs):
+        self.use_binary = kwargs.pop('use_binary', False)
+        self._seq = 0
+        self._req_id = 0
+        self._drain_pos = 0
+        self._sniff_pos = 0
         self.dev = BaseDevice(*args, **kwargs)
+        self._boot_baudrate = self.dev.get_baudrate()
 
     @staticmethod
     def _error_msg(data):
@@ -62,8 +101,10 @@ class PhilipBaseIf():
         if 'data' in cmd_info:
             cmd_info['data'] = PhilipBaseIf._bytes_to_int(cmd_info['data'])
 
-    def _send_cmd(self, send_cmd, timeout, end_key='result',):
+    def _send_cmd(self, send_cmd, timeout, end_key='result', baudrate=None):
         self.dev.writeline(send_cmd)
+        if baudrate is not None:
+            self.dev.set_baudrate(baudrate)
         cmd_info = {}
         decode_error = False
         while end_key not in cmd_info:
@@ -76,12 +117,14 @@ class PhilipBaseIf():
             raise json.decoder.JSONDecodeError
         return cmd_info
 
-    def send_and_parse_cmd(self, send_cmd, to_byte_array=False, timeout=None):
+    def send_and_parse_cmd(self, send_cmd, to_byte_array=False, timeout=None,
+                           baudrate=None):
         """Returns a dictionary with information from the event
         Args:
             send_cmd(str): The command to write to the device
             to_byte_array: If True and data is bytes leave it as an array
             timeout: Optional timeout value for command specific timeouts
+            baudrate: Optional baudrate to read the response with
         Returns:
             dict:
             The return hold dict values in the following keys::
@@ -93,24 +136,195 @@ class PhilipBaseIf():
 
         cmd_info = {'cmd': send_cmd}
         try:
-            cmd_info.update(self._send_cmd(send_cmd, timeout=timeout))
+            cmd_info.update(self._send_cmd(send_cmd, timeout=timeout,
+                                           baudrate=baudrate))
+        except json.decoder.JSONDecodeError:
+            cmd_info['result'] = self.RESULT_ERROR
+            cmd_info['msg'] = "Failed to parse response"
+        except TimeoutError:
+            cmd_info['result'] = self.RESULT_TIMEOUT
+        else:
+            self._parse_result(cmd_info, to_byte_array)
+        return cmd_info
+
+    def _parse_result(self, cmd_info, to_byte_array):
+        if cmd_info['result'] == 0:
+            cmd_info['result'] = self.RESULT_SUCCESS
             if to_byte_array is False:
                 if 'data' in cmd_info:
                     self._try_data_to_int(cmd_info)
-        except json.decoder.JSONDecodeError:
+        else:
+            cmd_info['data'] = cmd_info['result']
             cmd_info['result'] = self.RESULT_ERROR
-            cmd_info['msg'] = "Failed to parse response"
+            cmd_info['msg'] = self._error_msg(cmd_info['data'])
+
+    def send_and_parse_cmds(self, send_cmds, to_byte_array=False,
+                            timeout=None):
+        """Sends commands back-to-back and matches the responses by id
+
+        Each command is prefixed with a request id that the device echoes in
+        the response.  Commands are sent without waiting for the previous
+        response as long as less than PIPELINE_BYTES are in flight.
+
+        Args:
+            send_cmds(list): The commands to write to the device
+            to_byte_array: If True and data is bytes leave it as an array
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            list: A dict for each command, see send_and_parse_cmd()
+        """
+        results = [{'cmd': send_cmd} for send_cmd in send_cmds]
+        pending = {}
+        pending_bytes = 0
+        next_cmd = 0
+        while next_cmd < len(send_cmds) or pending:
+            while next_cmd < len(send_cmds):
+                line = '@{} {}'.format(self._req_id, send_cmds[next_cmd])
+                if pending and \
+                        pending_bytes + len(line) + 1 > self.PIPELINE_BYTES:
+                    break
+                self.dev.writeline(line, flush_input=not pending)
+                pending[self._req_id] = (next_cmd, len(line) + 1)
+                pending_bytes += len(line) + 1
+                self._req_id = (self._req_id + 1) & 0xFFFF
+                next_cmd += 1
+            try:
+                line = self.dev.readline(timeout)
+            except TimeoutError:
+                break
+            try:
+                response = json.loads(line)
+                index, size = pending.pop(response.pop('id'))
+            except (json.decoder.JSONDecodeError, AttributeError, KeyError):
+                logging.debug("Unmatched response: %r", line)
+                continue
+            pending_bytes -= size
+            results[index].update(response)
+            self._parse_result(results[index], to_byte_array)
+        for cmd_info in results:
+            if 'result' not in cmd_info:
+                cmd_info['result'] = self.RESULT_TIMEOUT
+        return results
+
+    @staticmethod
+    def _crc16(data):
+        """CRC-16/CCITT-FALSE used by the binary frames
+
+        >>> hex(PhilipBaseIf._crc16(b'123456789'))
+        '0x29b1'
+        """
+        crc = 0xFFFF
+        for byte in data:
+            crc ^= byte << 8
+            for _ in range(8):
+                if crc & 0x8000:
+                    crc = ((crc << 1) ^ 0x1021) & 0xFFFF
+                else:
+                    crc = (crc << 1) & 0xFFFF
+        return crc
+
+    @staticmethod
+    def _encode_frame(seq, payload):
+        """Packs a payload into a binary frame
+
+        >>> PhilipBaseIf._encode_frame(1, b'\\x03').hex()
+        'a50101000327f5'
+        """
+        frame = struct.pack('<BH', seq & 0xFF, len(payload)) + bytes(payload)
+        crc = PhilipBaseIf._crc16(frame)
+        return bytes([PhilipBaseIf.BIN_SOF]) + frame + struct.pack('<H', crc)
+
+    @staticmethod
+    def _decode_frame(frame):
+        """Unpacks a binary frame
+
+        Args:
+            frame(bytes): The full frame including start byte and CRC
+        Returns:
+            tuple: The sequence number and the payload
+        Raises:
+            ValueError: if the frame is malformed or the CRC does not match
+        """
+        if len(frame) < PhilipBaseIf.BIN_HDR_SIZE + PhilipBaseIf.BIN_CRC_SIZE:
+            raise ValueError("Frame too short")
+        if frame[0] != PhilipBaseIf.BIN_SOF:
+            raise ValueError("Invalid start of frame")
+        seq, size = struct.unpack_from('<BH', frame, 1)
+        if len(frame) != size + PhilipBaseIf.BIN_HDR_SIZE + \
+                PhilipBaseIf.BIN_CRC_SIZE:
+            raise ValueError("Frame size mismatch")
+        crc = struct.unpack_from('<H', frame, len(frame) - 2)[0]
+        if crc != PhilipBaseIf._crc16(frame[1:-2]):
+            raise ValueError("CRC mismatch")
+        return seq, frame[PhilipBaseIf.BIN_HDR_SIZE:-2]
+
+    def _send_frame(self, payload, timeout):
+        self._seq = (self._seq + 1) & 0xFF
+        self.dev.write(self._encode_frame(self._seq, payload))
+        header = self.dev.read(self.BIN_HDR_SIZE, timeout)
+        # Skip anything before the start of frame, such as startup messages
+        while header[0] != self.BIN_SOF:
+            header = header[1:] + self.dev.read(1, timeout)
+        size = struct.unpack_from('<H', header, 2)[0]
+        frame = header + self.dev.read(size + self.BIN_CRC_SIZE, timeout)
+        seq, resp = self._decode_frame(frame)
+        if seq != self._seq:
+            raise ValueError("Sequence mismatch")
+        return resp
+
+    def send_and_parse_frame(self, payload, cmd=None, to_byte_array=False,
+                             timeout=None):
+        """Returns a dictionary with information from a binary frame command
+        Args:
+            payload(bytes): The command byte followed by the arguments
+            cmd(str): Description of the command for tracking, defaults to the
+                      payload in hex
+            to_byte_array: If True and data is bytes leave it as an array
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+        """
+        cmd_info = {'cmd': cmd or payload.hex()}
+        try:
+            resp = self._send_frame(payload, timeout=timeout)
+        except ValueError as exc:
+            cmd_info['result'] = self.RESULT_ERROR
+            cmd_info['msg'] = "Failed to parse response: {}".format(exc)
         except TimeoutError:
             cmd_info['result'] = self.RESULT_TIMEOUT
         else:
-            if cmd_info['result'] == 0:
+            if len(resp) < 2 or resp[0] != payload[0]:
+                cmd_info['result'] = self.RESULT_ERROR
+                cmd_info['msg'] = "Failed to parse response"
+            elif resp[1] == 0:
                 cmd_info['result'] = self.RESULT_SUCCESS
+                if len(resp) > 2:
+                    cmd_info['data'] = list(resp[2:])
+                    if to_byte_array is False:
+                        self._try_data_to_int(cmd_info)
             else:
-                cmd_info['data'] = cmd_info['result']
+                cmd_info['data'] = resp[1]
                 cmd_info['result'] = self.RESULT_ERROR
                 cmd_info['msg'] = self._error_msg(cmd_info['data'])
         return cmd_info
 
+    @staticmethod
+    def _fits_u16(*args):
+        """Checks the arguments fit the 16 bit fields of a binary frame
+
+        >>> PhilipBaseIf._fits_u16(0, 65535)
+        True
+        >>> PhilipBaseIf._fits_u16(99999)
+        False
+        """
+        return all(0 <= int(arg) <= 0xFFFF for arg in args)
+
+    def _range_error(self, cmd):
+        """Result of a command with an argument that does not fit a frame"""
+        return {'cmd': cmd, 'data': errno.ERANGE,
+                'result': self.RESULT_ERROR,
+                'msg': self._error_msg(errno.ERANGE)}
+
     def read_bytes(self, index, size=1, to_byte_array=False, timeout=None):
         """Reads bytes in the register map
         Args:
@@ -121,8 +335,82 @@ class PhilipBaseIf():
         Returns:
             see send_and_parse_cmd()
         """
-        return self.send_and_parse_cmd('rr {} {}'.format(index, size),
-                                       to_byte_array, timeout)
+        cmd = 'rr {} {}'.format(index, size)
+        if self.use_binary:
+            if not self._fits_u16(index, size):
+                return self._range_error(cmd)
+            payload = struct.pack('<BHH', self.BIN_CMD_READ_REG, int(index),
+                                  int(size))
+            return self.send_and_parse_frame(payload, cmd, to_byte_array,
+                                             timeout)
+        return self.send_and_parse_cmd(cmd, to_byte_array, timeout)
+
+    @staticmethod
+    def _batch_spans(spans, max_spans, max_size):
+        """Splits byte ranges into batches that fit in a single read
+
+        >>> list(PhilipBaseIf._batch_spans([(0, 4), (8, 6)], 32, 8))
+        [[(0, 4), (8, 4)], [(12, 2)]]
+        """
+        batch = []
+        batch_size = 0
+        for index, size in spans:
+            index = int(index)
+            size = int(size)
+            while size > 0:
+                if len(batch) == max_spans or batch_size == max_size:
+                    yield batch
+                    batch = []
+                    batch_size = 0
+                chunk = min(size, max_size - batch_size)
+                batch.append((index, chunk))
+                batch_size += chunk
+                index += chunk
+                size -= chunk
+        if batch:
+            yield batch
+
+    def read_bytes_list(self, spans, timeout=None):
+        """Reads several ranges of bytes in the register map
+
+        The ranges are read with as few commands as the device buffer allows,
+        a single command if they fit.
+
+        Args:
+            spans: List of (index, size) tuples of the ranges to read
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+            data is a list of the bytes of all ranges back to back
+        """
+        max_size = self.READ_REGS_MAX_SIZE
+        if self.use_binary:
+            max_size = self.BIN_READ_REGS_MAX_SIZE
+        batches = list(self._batch_spans(spans, self.READ_REGS_MAX_SPANS,
+                                         max_size))
+        if not batches:
+            raise ValueError("No bytes to read")
+        cmds = []
+        data = []
+        for batch in batches:
+            cmd = 'rrs' + ''.join(' {} {}'.format(*span) for span in batch)
+            if self.use_binary:
+                if not self._fits_u16(*sum(batch, ())):
+                    return self._range_error(cmd)
+                payload = bytes([self.BIN_CMD_READ_REGS])
+                for index, size in batch:
+                    payload += struct.pack('<HH', index, size)
+                cmd_info = self.send_and_parse_frame(payload, cmd, True,
+                                                     timeout)
+            else:
+                cmd_info = self.send_and_parse_cmd(cmd, True, timeout)
+            if cmd_info['result'] != self.RESULT_SUCCESS:
+                return cmd_info
+            cmds.append(cmd_info['cmd'])
+            data += cmd_info['data']
+        cmd_info['cmd'] = cmds[0] if len(cmds) == 1 else cmds
+        cmd_info['data'] = data
+        return cmd_info
 
     def read_bits(self, index, offset, bit_amount, timeout=None):
         """Read specific bits in the register map
@@ -161,6 +449,17 @@ class PhilipBaseIf():
                 ret_str += ' {}'.format((int(data) >> ((i) * 8)) & 0xFF)
         return ret_str
 
+    @staticmethod
+    def _write_byte_arg_to_bytes(data, size):
+        """
+        >>> PhilipBaseIf._write_byte_arg_to_bytes(0x1234, 2)
+        b'4\\x12'
+        """
+        if not isinstance(data, list):
+            data = [data]
+        return bytes((int(data_byte) >> (i * 8)) & 0xFF
+                     for data_byte in data for i in range(0, size))
+
     def write_bytes(self, index, data, size=1, timeout=None):
         """Writes bytes in the register map
         Args:
@@ -173,6 +472,12 @@ class PhilipBaseIf():
         """
         cmd = "wr {}{}".format(index,
                                self._write_byte_arg_to_string(data, size))
+        if self.use_binary:
+            if not self._fits_u16(index):
+                return self._range_error(cmd)
+            payload = struct.pack('<BH', self.BIN_CMD_WRITE_REG, int(index))
+            payload += self._write_byte_arg_to_bytes(data, size)
+            return self.send_and_parse_frame(payload, cmd, timeout=timeout)
         return self.send_and_parse_cmd(cmd, timeout=timeout)
 
 # pylint: disable=R0913
@@ -221,6 +526,9 @@ class PhilipBaseIf():
         Returns:
             see send_and_parse_cmd()
         """
+        if self.use_binary:
+            return self.send_and_parse_frame(bytes([self.BIN_CMD_EXECUTE]),
+                                             "ex", timeout=timeout)
         return self.send_and_parse_cmd("ex", timeout=timeout)
 
     def reset_mcu(self, timeout=None):
@@ -231,7 +539,159 @@ class PhilipBaseIf():
         Returns:
             see send_and_parse_cmd()
         """
-        return self.send_and_parse_cmd("mcu_rst", timeout=timeout)
+        # The device restarts with its default baudrate whatever was
+        # negotiated before
+        return self.send_and_parse_cmd("mcu_rst", timeout=timeout,
+                                       baudrate=self.IF_BOOT_BAUDRATE)
+
+    def set_if_baudrate(self, baudrate, timeout=None):
+        """Negotiates a new baudrate for the interface
+
+        The device switches after responding and falls back to the previous
+        baudrate if it does not get a command at the new baudrate within
+        IF_BAUD_TIMEOUT.  The switch is confirmed with a version command.
+
+        Args:
+            baudrate(int): The new baudrate
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+        """
+        prev_baudrate = self.dev.get_baudrate()
+        cmd_info = self.send_and_parse_cmd("baud {}".format(baudrate),
+                                           timeout=timeout)
+        if cmd_info['result'] != self.RESULT_SUCCESS:
+            return cmd_info
+        self.dev.set_baudrate(baudrate)
+        confirm_info = self.get_version(timeout)
+        if confirm_info['result'] != self.RESULT_SUCCESS:
+            self.dev.set_baudrate(prev_baudrate)
+            time.sleep(self.IF_BAUD_TIMEOUT)
+            cmd_info['result'] = confirm_info['result']
+            cmd_info['msg'] = "Baudrate not confirmed, using {}".format(
+                prev_baudrate)
+        return cmd_info
+
+    def dump_trace(self, since=None, timeout=None):
+        """Dumps the valid trace entries oldest first with binary frames
+
+        The device packs as many records as fit in a frame, following frames
+        are requested until all valid entries are received.
+
+        Args:
+            since: Sequence number of the oldest entry to dump, None for all
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+            data is a list of (tick_div, source, tick, value, seq) tuples
+        """
+        records = []
+        while True:
+            payload = struct.pack('<BH', self.BIN_CMD_DUMP_TRACE, len(records))
+            if since is not None:
+                payload += struct.pack('<I', since & 0xFFFFFFFF)
+            cmd_info = self.send_and_parse_frame(payload, 'dump_trace',
+                                                 to_byte_array=True,
+                                                 timeout=timeout)
+            if cmd_info['result'] != self.RESULT_SUCCESS:
+                return cmd_info
+            data = bytes(cmd_info['data'])
+            total = struct.unpack_from('<H', data)[0]
+            for source, tick_div, value, tick, seq in \
+                    self.TRACE_RECORD.iter_unpack(data[2:]):
+                records.append((tick_div, source, tick, value, seq))
+            if len(records) >= total or len(data) == 2:
+                break
+        cmd_info['data'] = records
+        return cmd_info
+
+    def drain_trace(self, timeout=None):
+        """Drains the events queued in the stream ring with binary frames
+
+        Only events of the trace.mode.stream mode are queued.  The device
+        keeps the events until the following drain acknowledges them so a
+        failed drain can be repeated without losing events.
+
+        The device does not push events, the ring only holds
+        trace.stream_size events and must be drained faster than it fills.
+        Events that did not fit are lost, trace.dropped counts them per
+        source and trace.stream_overruns in total.
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+            data is a list of (tick_div, source, tick, value, seq) tuples
+            pending is the amount of events still queued
+        """
+        records = []
+        while True:
+            payload = struct.pack('<BH', self.BIN_CMD_DRAIN_TRACE,
+                                  self._drain_pos)
+            cmd_info = self.send_and_parse_frame(payload, 'drain_trace',
+                                                 to_byte_array=True,
+                                                 timeout=timeout)
+            if cmd_info['result'] != self.RESULT_SUCCESS:
+                return cmd_info
+            data = bytes(cmd_info['data'])
+            pos, pending = struct.unpack_from('<HH', data)
+            received = 0
+            for source, tick_div, value, tick, seq in \
+                    self.TRACE_RECORD.iter_unpack(data[4:]):
+                records.append((tick_div, source, tick, value, seq))
+                received += 1
+            self._drain_pos = (pos + received) & 0xFFFF
+            if received >= pending:
+                break
+        cmd_info['data'] = records
+        cmd_info['pending'] = pending - received
+        return cmd_info
+
+    def drain_spi_sniff(self, timeout=None):
+        """Drains the frames recorded by the spi sniffer with binary frames
+
+        Like drain_trace() the device keeps the frames until the following
+        drain acknowledges them.
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+            data is a list of dicts with the tick when NSS lowered, the
+            duration in ticks, the size in bytes, the flags and the mosi and
+            miso bytes
+            pending is the amount of frames still recorded
+        """
+        frames = []
+        while True:
+            payload = struct.pack('<BH', self.BIN_CMD_DRAIN_SPI_SNIFF,
+                                  self._sniff_pos)
+            cmd_info = self.send_and_parse_frame(payload, 'drain_spi_sniff',
+                                                 to_byte_array=True,
+                                                 timeout=timeout)
+            if cmd_info['result'] != self.RESULT_SUCCESS:
+                return cmd_info
+            data = bytes(cmd_info['data'])
+            pos, pending = struct.unpack_from('<HH', data)
+            offset = 4
+            received = 0
+            while offset < len(data):
+                tick, duration, size, length, flags = \
+                    self.SPI_SNIFF_HDR.unpack_from(data, offset)
+                offset += self.SPI_SNIFF_HDR.size
+                frames.append({'tick': tick, 'duration': duration,
+                               'size': size, 'flags': flags,
+                               'mosi': list(data[offset:offset + length]),
+                               'miso': list(data[offset + length:
+                                                 offset + 2 * length])})
+                offset += 2 * length
+                received += 1
+            self._sniff_pos = (pos + received) & 0xFFFF
+            if received >= pending or received == 0:
+                break
+        cmd_info['data'] = frames
+        cmd_info['pending'] = pending - received
+        return cmd_info
 
     def get_version(self, timeout=None):
         """Get the version of the interface/memory map that is being used
@@ -277,8 +737,27 @@ class PhilipExtIf(PhilipBaseIf):
         use_dev_map - keyword arg that scans the device for the internal
                       memory map (it may take longer and not have as much
                       information)
+        if_baudrate - keyword arg for the interface baudrate negotiated when
+                      connecting and after resets, the default None keeps
+                      the baudrate used to connect, DEFAULT_IF_BAUDRATE is
+                      faster if the serial adapter supports it
         (*args, **kwargs) -> See base_device for documentation of args
     """
+    # A fast interface baudrate to pass as if_baudrate
+    DEFAULT_IF_BAUDRATE = 1000000
+
+    # Functions of the prof.entry registers in order, see PROF_ID in prof.h
+    PROF_NAMES = ['parse_command', 'parse_frame', '_flush_tmr_buf',
+                  'poll_dut_spi_ic', '_i2c_it', '_spi_reg_int']
+
+    # Sources of the trace.dropped registers in order
+    TRACE_SOURCES = ['DEBUG0', 'DEBUG1', 'DEBUG2', 'DUT_IC']
+    # Conditions of trace.mode.trig in order, see TRACE_TRIG in trace.h
+    TRACE_TRIGS = ['none', 'event', 'write', 'count', 'tick']
+    # Arrays of a trace entry in the order of the _trace_event() arguments,
+    # trace.tick_hi is added to the tick
+    TRACE_ARRAYS = ['trace.tick_div', 'trace.source', 'trace.tick',
+                    'trace.value', 'trace.seq', 'trace.tick_hi']
 
     def __init__(self, *args, **kwargs):
         map_path = ''
@@ -287,10 +766,16 @@ class PhilipExtIf(PhilipBaseIf):
             map_path = kwargs.pop('map_path')
         if 'use_dev_map' in kwargs:
             use_dev_map = kwargs.pop('use_dev_map')
+        if_baudrate = kwargs.pop('if_baudrate', None)
 
         super().__init__(*args, **kwargs)
+        self._if_baudrate = None
+        self._trace_seq = None
+        self._trace_count = None
+        self._trace_dropped = None
+        self._stream_seq = None
         try:
-            self.if_version = self.get_version()['version']
+            self.if_version = self._connect_if(if_baudrate)['version']
         except (TimeoutError, KeyError):
             logging.debug("No device detected, functionality will be limited")
             self.if_version = "UNKNOWN"
@@ -305,6 +790,38 @@ class PhilipExtIf(PhilipBaseIf):
 
         self._sys_clock = None
 
+    def _connect_if(self, if_baudrate):
+        version_info = self.get_version()
+        if not if_baudrate or if_baudrate == self._boot_baudrate:
+            return version_info
+        if version_info['result'] == self.RESULT_TIMEOUT:
+            # The device may still use the baudrate of a previous connection
+            self.dev.set_baudrate(if_baudrate)
+            version_info = self.get_version()
+            if version_info['result'] == self.RESULT_TIMEOUT:
+                self.dev.set_baudrate(self._boot_baudrate)
+                return version_info
+        elif self.set_if_baudrate(if_baudrate)['result'] != \
+                self.RESULT_SUCCESS:
+            logging.debug("Using %r baud for the interface",
+                          self._boot_baudrate)
+            return version_info
+        self._if_baudrate = if_baudrate
+        return version_info
+
+    def reset_mcu(self, timeout=None):
+        """Resets the device and renegotiates the interface baudrate
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see send_and_parse_cmd()
+        """
+        cmd_info = super().reset_mcu(timeout)
+        if cmd_info['result'] == self.RESULT_SUCCESS and self._if_baudrate:
+            self.set_if_baudrate(self._if_baudrate, timeout)
+        return cmd_info
+
     def scan_dev_map(self):
         """Scans the device for memory map information
 
@@ -391,6 +908,8 @@ class PhilipExtIf(PhilipBaseIf):
             num = c_uint32(num).value
         if prim_type == "int32_t":
             num = c_int32(num).value
+        if prim_type == "int64_t":
+            num = c_int64(num).value
         return num
 
     @staticmethod
@@ -483,9 +1002,52 @@ class PhilipExtIf(PhilipBaseIf):
                            response['cmd']]
         return response
 
+    @staticmethod
+    def _record_span(cmd):
+        """Gets the (index, size) of the bytes holding a memory map record
+
+        >>> PhilipExtIf._record_span({'offset': 4, 'bits': 3, 'bit_offset': 6,
+        ...                           'total_size': '', 'type_size': 1})
+        (4, 2)
+        """
+        if cmd['bits'] != '':
+            return (cmd['offset'],
+                    int((cmd['bits'] - 1 + cmd['bit_offset'])/8 + 1))
+        if cmd['total_size'] != '':
+            return (cmd['offset'], cmd['total_size'])
+        return (cmd['offset'], cmd['type_size'])
+
+    @staticmethod
+    def _merge_spans(spans):
+        """Merges overlapping or adjacent byte ranges
+
+        >>> PhilipExtIf._merge_spans([(4, 2), (0, 4), (5, 1), (8, 1)])
+        [(0, 6), (8, 1)]
+        """
+        merged = []
+        for index, size in sorted(spans):
+            if merged and index <= merged[-1][0] + merged[-1][1]:
+                last_index, last_size = merged[-1]
+                merged[-1] = (last_index,
+                              max(last_size, index + size - last_index))
+            else:
+                merged.append((index, size))
+        return merged
+
+    def _parse_record(self, cmd, data):
+        if cmd['bits'] != '':
+            data = self._bytes_to_int(data) >> cmd['bit_offset']
+            return data & ((2 ** cmd['bits']) - 1)
+        if cmd.get('array_size', '') != '':
+            return self._parse_array(data, cmd['type_size'], cmd['type'])
+        return self._c_cast(self._bytes_to_int(data), cmd['type'])
+
     def read_struct(self, cmd_name, data_has_name=True, timeout=None):
         """Reads a set of registers defined by the memory map
 
+        All registers are read with a single scatter-gather read, the ranges
+        are taken from the memory map and merged where they touch.
+
         Args:
             cmd_name(str): The name if the structure to read
             data_has_cmd: Include the record name in the data
@@ -493,14 +1055,35 @@ class PhilipExtIf(PhilipBaseIf):
         Returns:
             see send_and_parse_cmd()
         """
+        names = [cmd for cmd in self.mem_map.keys()
+                 if cmd.startswith(cmd_name) and not cmd.endswith('.res')]
+        if not names:
+            return []
+        spans = self._merge_spans([self._record_span(self.mem_map[name])
+                                   for name in names])
+        cmd_info = self.read_bytes_list(spans, timeout)
+        if cmd_info['result'] != self.RESULT_SUCCESS:
+            return [cmd_info]
+        data_index = []
+        pos = 0
+        for index, size in spans:
+            data_index.append((index, size, pos))
+            pos += size
         response = []
-        for cmd in self.mem_map.keys():
-            # Suppress unused variable warning
-
-            if cmd.startswith(cmd_name) and not cmd.endswith('.res'):
-                response.append(self.read_reg(cmd, timeout=timeout))
-                if data_has_name:
-                    response[-1]['data'] = {cmd: response[-1]['data']}
+        for name in names:
+            cmd = self.mem_map[name]
+            index, size = self._record_span(cmd)
+            for span_index, span_size, pos in data_index:
+                if span_index <= index < span_index + span_size:
+                    pos += index - span_index
+                    break
+            data = self._parse_record(cmd, cmd_info['data'][pos:pos + size])
+            if data_has_name:
+                data = {name: data}
+            response.append({'cmd': ['read_reg({},0,{})'.format(name, size),
+                                     cmd_info['cmd']],
+                             'data': data,
+                             'result': cmd_info['result']})
         return response
 
     def write_and_execute(self, cmd_name, data, timeout=None):
@@ -523,6 +1106,40 @@ class PhilipExtIf(PhilipBaseIf):
         response.append(self.execute_changes(timeout=timeout))
         return response
 
+    def arm_trace_trigger(self, trig, pre_depth=0, post_depth=0,
+                          timeout=None, **conditions):
+        """Limits the trace to a window around a trigger condition
+
+        Like a logic analyser the last pre_depth events before the trigger
+        and the post_depth events from the trigger on are traced, arming
+        clears the trace registers.  trace.trig_state shows when the window
+        is full and trace.trig_seq is the sequence number of the first event
+        from the trigger on.
+
+        Args:
+            trig: The condition of TRACE_TRIGS by name or number
+            pre_depth: Events before the trigger kept in the window
+            post_depth: Events from the trigger on, 0 for no end
+            timeout: Optional timeout value for command specific timeouts
+            conditions: Values of the condition, trig_source, trig_value,
+                        trig_addr, trig_count or trig_tick
+        Returns:
+            see send_and_parse_cmd()
+        """
+        if trig in self.TRACE_TRIGS:
+            trig = self.TRACE_TRIGS.index(trig)
+        response = [self.write_reg('trace.mode.init', 0, timeout=timeout),
+                    self.write_reg('trace.mode.trig', trig, timeout=timeout),
+                    self.write_reg('trace.pre_depth', pre_depth,
+                                   timeout=timeout),
+                    self.write_reg('trace.post_depth', post_depth,
+                                   timeout=timeout)]
+        for name, value in conditions.items():
+            response.append(self.write_reg('trace.' + name, value,
+                                           timeout=timeout))
+        response.append(self.execute_changes(timeout=timeout))
+        return response
+
     def dut_reset(self, reset_time=0.3, timeout=None):
         """Provides a reset to the dut
 
@@ -546,25 +1163,235 @@ class PhilipExtIf(PhilipBaseIf):
     def read_trace(self, to_ns=False):
         """Reads event trace from the dut
 
+        Args:
+            to_ns: Report the time in ns instead of seconds
         Returns:
             see send_and_parse_cmd()
             formatted to return the time sorted events
+            lost is the amount of events missing between the read events
+            loss has the amount of events each source dropped since the
+            previous read and the ratio to all events of the source
+        """
+        return self._read_trace(to_ns, False, "read_trace()")
+
+    def read_trace_since(self, to_ns=False):
+        """Reads the events stored since the previous read of the trace
+
+        Only the new entries are transferred, the first call reads the whole
+        trace like read_trace().  The binary interface dumps the entries
+        following the last sequence number, otherwise trace.count and
+        trace.index give the slots that changed since the previous read.
+
+        Args:
+            to_ns: Report the time in ns instead of seconds
+        Returns:
+            see read_trace()
+            lost also counts the events missing since the previous read
         """
+        return self._read_trace(to_ns, self._trace_seq is not None,
+                                "read_trace_since()")
+
+    def _read_trace(self, to_ns, resume, name):
         if not self._sys_clock:
             self._sys_clock = self.read_reg('sys.sys_clk')['data']
-        trace = []
-        response = {"cmd": "read_trace()", "result": self.RESULT_SUCCESS}
+        since = self._trace_seq if resume else None
+        response = {"cmd": name, "result": self.RESULT_SUCCESS}
+        names = ['trace.dropped', 'trace.next_seq']
+        if not self.use_binary:
+            names += ['trace.index', 'trace.count']
+        cursor = self._read_records(names)
+        if cursor['result'] != self.RESULT_SUCCESS:
+            return cursor
+        cursor = cursor['data']
+        if self.use_binary:
+            dump = self.dump_trace(since)
+            if dump['result'] != self.RESULT_SUCCESS:
+                return dump
+            trace = [self._trace_event(*record, to_ns=to_ns)
+                     for record in dump['data']]
+        elif resume:
+            total_size = int(self.mem_map['trace.tick']['array_size'])
+            amount = min((cursor['trace.count'] - self._trace_count) &
+                         0xFFFFFFFF, total_size)
+            slots = self._get_trace_slots(cursor['trace.index'] - amount,
+                                          amount, to_ns)
+            if slots['result'] != self.RESULT_SUCCESS:
+                return slots
+            # Entries may be overwritten after the cursor was read
+            trace = [event for event in slots['data']
+                     if (event['seq'] - since) & 0xFFFFFFFF < 0x80000000]
+        else:
+            trace = []
+            total_size = int(self.mem_map['trace.tick']['array_size'])
+            # must have a chunk that will not cause buffer overflow
+            chunk_size = 32 + 16
+            index = 0
+            while index + chunk_size < total_size:
+                self._get_trace_events(trace, index, chunk_size, to_ns)
+                index += chunk_size
+            chunk_size = total_size - index
+            if chunk_size:
+                self._get_trace_events(trace, index, chunk_size, to_ns)
+        self._trace_count = cursor.get('trace.count')
+
+        response['lost'], next_seq = self._trace_lost(trace, since)
+        if next_seq is None:
+            next_seq = cursor['trace.next_seq']
+        self._trace_seq = next_seq
+        response['loss'] = self._trace_loss(trace, cursor['trace.dropped'])
+        response['data'] = self._sort_trace(trace)
+        return response
+
+    def _read_records(self, names, timeout=None):
+        """Reads memory map records with a single scatter-gather read
+
+        Returns:
+            see send_and_parse_cmd()
+            data is a dict of the record names and values
+        """
+        spans = [self._record_span(self.mem_map[name]) for name in names]
+        cmd_info = self.read_bytes_list(spans, timeout)
+        if cmd_info['result'] != self.RESULT_SUCCESS:
+            return cmd_info
+        data = cmd_info['data']
+        cmd_info['data'] = {}
+        for name, (_, size) in zip(names, spans):
+            cmd_info['data'][name] = self._parse_record(self.mem_map[name],
+                                                        data[:size])
+            data = data[size:]
+        return cmd_info
+
+    def _get_trace_slots(self, first, amount, to_ns):
+        """Reads the trace entries of consecutive slots in one read
+
+        The slots wrap at the end of the trace arrays.
+
+        Returns:
+            see send_and_parse_cmd()
+            data is a list of the events of the used slots
+        """
+        if amount <= 0:
+            return {'cmd': [], 'data': [], 'result': self.RESULT_SUCCESS}
         total_size = int(self.mem_map['trace.tick']['array_size'])
-        # must have a chunk that will not cause buffer overflow
-        chunk_size = 32 + 16
-        index = 0
-        while index + chunk_size < total_size:
-            self._get_trace_events(trace, index, chunk_size, to_ns)
-            index += chunk_size
-        chunk_size = total_size - index
-        if chunk_size:
-            self._get_trace_events(trace, index, chunk_size, to_ns)
+        first %= total_size
+        ranges = [(first, min(amount, total_size - first))]
+        if amount > ranges[0][1]:
+            ranges.append((0, amount - ranges[0][1]))
+        spans = []
+        for name in self.TRACE_ARRAYS:
+            cmd = self.mem_map[name]
+            for start, size in ranges:
+                spans.append((cmd['offset'] + start * cmd['type_size'],
+                              size * cmd['type_size']))
+        cmd_info = self.read_bytes_list(spans)
+        if cmd_info['result'] != self.RESULT_SUCCESS:
+            return cmd_info
+        data = cmd_info['data']
+        arrays = []
+        for name in self.TRACE_ARRAYS:
+            cmd = self.mem_map[name]
+            size = amount * cmd['type_size']
+            arrays.append(self._parse_array(data[:size], cmd['type_size'],
+                                            cmd['type']))
+            data = data[size:]
+        cmd_info['data'] = [self._trace_event(tick_div, source,
+                                              tick | (tick_hi << 32),
+                                              value, seq, to_ns)
+                            for tick_div, source, tick, value, seq, tick_hi
+                            in zip(*arrays) if source != 0]
+        return cmd_info
+
+    @staticmethod
+    def _trace_lost(trace, since=None):
+        """Counts the sequence numbers missing between the events
+
+        Sequence numbers wrap at 32 bits, a missing sequence number is an
+        event that was overwritten or not stored.  Without since the oldest
+        event is the one following the largest gap.
+
+        Returns:
+            The amount of missing events and the sequence number following
+            the newest event, None if there are no events
+        """
+        seqs = sorted(event['seq'] for event in trace)
+        if not seqs:
+            return 0, since
+        if since is None:
+            gaps = [(seqs[0] - seqs[-1]) & 0xFFFFFFFF]
+            gaps += [seqs[i] - seqs[i - 1] for i in range(1, len(seqs))]
+            since = seqs[gaps.index(max(gaps))]
+        seqs = sorted((seq - since) & 0xFFFFFFFF for seq in seqs)
+        lost = seqs[-1] + 1 - len(seqs)
+        return lost, (since + seqs[-1] + 1) & 0xFFFFFFFF
+
+    def _trace_loss(self, trace, dropped):
+        """Gets the events dropped by each source since the last call"""
+        prev = self._trace_dropped or [0] * len(dropped)
+        self._trace_dropped = dropped
+        loss = {}
+        for source, now, before in zip(self.TRACE_SOURCES, dropped, prev):
+            lost = (now - before) & 0xFFFFFFFF
+            seen = sum(1 for event in trace if event['source'] == source)
+            loss[source] = {'dropped': lost,
+                            'rate': lost / (lost + seen) if lost else 0.0}
+        return loss
+
+    def start_trace_stream(self, timeout=None):
+        """Queues events in the stream ring instead of the trace registers
+
+        The ring holds trace.stream_size events, read_trace_stream() needs to
+        be called before it fills up or events are lost.  Check
+        trace.dropped for the events each source lost.
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see write_and_execute()
+        """
+        self._drain_pos = 0
+        self._stream_seq = None
+        return self.write_and_execute('trace.mode.stream', 1, timeout)
+
+    def stop_trace_stream(self, timeout=None):
+        """Stores events in the trace registers again
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see write_and_execute()
+        """
+        self._drain_pos = 0
+        return self.write_and_execute('trace.mode.stream', 0, timeout)
+
+    def read_trace_stream(self, to_ns=False):
+        """Reads the events queued since the last read of the stream
+
+        Returns:
+            see send_and_parse_cmd()
+            formatted like read_trace(), overruns is the amount of events
+            lost since the stream started because the ring was full, lost is
+            the amount of events missing since the previous read
+        """
+        if not self._sys_clock:
+            self._sys_clock = self.read_reg('sys.sys_clk')['data']
+        response = {"cmd": "read_trace_stream()"}
+        drain = self.drain_trace()
+        if drain['result'] != self.RESULT_SUCCESS:
+            return drain
+        overruns = self.read_reg('trace.stream_overruns')
+        if overruns['result'] != self.RESULT_SUCCESS:
+            return overruns
+        trace = [self._trace_event(*record, to_ns=to_ns)
+                 for record in drain['data']]
+        response['result'] = self.RESULT_SUCCESS
+        response['lost'], self._stream_seq = self._trace_lost(
+            trace, self._stream_seq)
+        response['data'] = self._sort_trace(trace)
+        response['overruns'] = overruns['data']
+        return response
 
+    @staticmethod
+    def _sort_trace(trace):
         sorted_events = sorted(trace, key=lambda x: x['time'])
         any_diff = 0
         ev_diff = {"DEBUG0": 0, "DEBUG1": 0, "DEBUG2": 0, "DUT_IC": 0}
@@ -578,15 +1405,12 @@ class PhilipExtIf(PhilipBaseIf):
                 event["source_diff"] = event["time"] - ev_diff[event['source']]
             ev_diff[event['source']] = event["time"]
             any_diff = event["time"]
-
-        response['data'] = sorted(trace, key=lambda x: x['time'])
-        return response
+        return sorted_events
 
     def _get_trace_events(self, trace, index, chunk_size, to_ns):
         logging.debug("_get_trace_events(trace=?, index=%r, "
                       "chunk_size=%r, to_ns=%r)",
                       index, chunk_size, to_ns)
-        # should be time in seconds
         trace_tick_divs = self.read_reg('trace.tick_div',
                                         index, chunk_size)['data']
         trace_sources = self.read_reg('trace.source',
@@ -595,37 +1419,47 @@ class PhilipExtIf(PhilipBaseIf):
                                     index, chunk_size)['data']
         trace_values = self.read_reg('trace.value',
                                      index, chunk_size)['data']
+        trace_seqs = self.read_reg('trace.seq', index, chunk_size)['data']
+        trace_ticks_hi = self.read_reg('trace.tick_hi',
+                                       index, chunk_size)['data']
         for _ in range(len(trace_ticks)):
-            trace_event = {}
-            trace_tick_div = trace_tick_divs[_]
-            trace_source = trace_sources[_]
-            trace_tick = trace_ticks[_]
-            trace_value = trace_values[_]
-            total_tick = trace_tick << trace_tick_div
-            time_sec = float(total_tick) / self._sys_clock
-            if to_ns:
-                trace_event['time'] = int(time_sec * 10000000000)
-            else:
-                trace_event['time'] = round(time_sec, 9)
-            if trace_source == 1:
-                trace_event['source'] = 'DEBUG0'
-            elif trace_source == 2:
-                trace_event['source'] = 'DEBUG1'
-            elif trace_source == 3:
-                trace_event['source'] = 'DEBUG2'
-            elif trace_source == 4:
-                trace_event['source'] = 'DUT_IC'
-            else:
-                trace_event['source'] = trace_source
+            if trace_sources[_] != 0:
+                trace.append(self._trace_event(trace_tick_divs[_],
+                                               trace_sources[_],
+                                               trace_ticks[_] |
+                                               (trace_ticks_hi[_] << 32),
+                                               trace_values[_],
+                                               trace_seqs[_], to_ns))
+
+    def _trace_event(self, trace_tick_div, trace_source, trace_tick,
+                     trace_value, trace_seq=None, to_ns=False):
+        trace_event = {}
+        # The tick has 64 bits, integer math keeps ns exact for long traces
+        total_tick = trace_tick << trace_tick_div
+        if to_ns:
+            trace_event['time'] = total_tick * 1000000000 // self._sys_clock
+        else:
+            trace_event['time'] = round(total_tick / self._sys_clock, 9)
+        if trace_source == 1:
+            trace_event['source'] = 'DEBUG0'
+        elif trace_source == 2:
+            trace_event['source'] = 'DEBUG1'
+        elif trace_source == 3:
+            trace_event['source'] = 'DEBUG2'
+        elif trace_source == 4:
+            trace_event['source'] = 'DUT_IC'
+        else:
+            trace_event['source'] = trace_source
 
-            if trace_value == 0:
-                trace_event['event'] = "FALLING"
-            elif trace_value == 1:
-                trace_event['event'] = "RISING"
-            else:
-                trace_event['event'] = trace_value
-            if trace_source != 0:
-                trace.append(trace_event)
+        if trace_value == 0:
+            trace_event['event'] = "FALLING"
+        elif trace_value == 1:
+            trace_event['event'] = "RISING"
+        else:
+            trace_event['event'] = trace_value
+        if trace_seq is not None:
+            trace_event['seq'] = trace_seq
+        return trace_event
 
     def _get_stats(self, vals: list):
         """Calculate stats of a list of values.
@@ -672,12 +1506,120 @@ class PhilipExtIf(PhilipBaseIf):
             self._sys_clock = self.read_reg('sys.sys_clk')['data']
         return self._sys_clock
 
-    def get_spi_clk_freqs(self) -> list:
+    def start_spi_sniff(self, timeout=None):
+        """Records the spi frames of other devices on the bus
+
+        PHiLIP does not drive MISO, the frames are read with
+        drain_spi_sniff() which must be called before the ring fills up.
+        The spi.mode.cpol and spi.mode.cpha must match the bus.  DUT_IC
+        shares the dma channel so it is disabled.
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see write_and_execute()
+        """
+        self._sniff_pos = 0
+        response = self._release_spi_dma(False, timeout)
+        response.extend(self.write_and_execute('spi.mode.if_type', 6,
+                                               timeout))
+        return response
+
+    def start_spi_dma(self, timeout=None):
+        """Selects the spi register interface served by dma
+
+        Writes are applied when NSS rises.  Only a single address byte is
+        supported so spi.mode.reg_16_bit must be 0.  The dma channels are
+        shared so DUT_IC and on the bluepill the DUT uart are disabled.
+
+        Args:
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            see write_and_execute()
+        """
+        response = self._release_spi_dma(True, timeout)
+        response.extend(self.write_and_execute('spi.mode.if_type', 5,
+                                               timeout))
+        return response
+
+    def _release_spi_dma(self, tx_dma, timeout):
+        # DUT_IC holds the spi rx dma channel and on the bluepill the DUT
+        # uart holds the spi tx dma channel, the execute commits them first
+        response = [self.write_reg('tmr.mode.init', 0, timeout=timeout),
+                    self.write_reg('tmr.mode.disable', 1, timeout=timeout)]
+        if tx_dma and self.read_reg('sys.status.board',
+                                    timeout=timeout)['data']:
+            response.append(self.write_reg('uart.mode.init', 0,
+                                           timeout=timeout))
+            response.append(self.write_reg('uart.mode.disable', 1,
+                                           timeout=timeout))
+        return response
+
+    def get_spi_sm(self) -> dict:
+        """Get the spi speed measurement registers with a single read.
+
+        Return:
+            dict of the spi.sm_ register names without the spi prefix to
+            their values, sm_buf only holds the captured timestamps.
+        """
+        regs = {}
+        for record in self.read_struct('spi.sm_'):
+            if record['result'] != self.RESULT_SUCCESS:
+                raise ConnectionError(record)
+            name, val = next(iter(record['data'].items()))
+            regs[name[len('spi.'):]] = val
+        regs['sm_buf'] = regs['sm_buf'][:regs['sm_edges']]
+        return regs
+
+    def get_spi_clk_summary(self) -> dict:
+        """Get the clock statistics the firmware measured on all edges.
+
+        The firmware keeps them while capturing so transfers of any length
+        can be characterised, committing the spi registers clears them.
+
+        Return:
+            dict containing the amount of edges, lost edges and frames, the
+            bit frequency and deadtime stats of all frames and the mean
+            frequency, bit rate and byte frequencies of the current or last
+            frame.  Frequencies are in Hz and deadtimes in ticks.
+        """
+        regs = self.get_spi_sm()
+        bits = {'num_values': regs['sm_bit_count'], 'mean': None,
+                'min': None, 'max': None}
+        if regs['sm_bit_count']:
+            bits['mean'] = (self.sys_clk() * regs['sm_bit_count'] /
+                            regs['sm_bit_sum'])
+            bits['min'] = self.sys_clk() / regs['sm_bit_max']
+            bits['max'] = self.sys_clk() / regs['sm_bit_min']
+        deadtimes = {'num_values': regs['sm_dead_count'], 'mean': None,
+                     'min': None, 'max': None}
+        if regs['sm_dead_count']:
+            deadtimes['mean'] = regs['sm_dead_sum'] / regs['sm_dead_count']
+            deadtimes['min'] = regs['sm_dead_min']
+            deadtimes['max'] = regs['sm_dead_max']
+        num_bytes = min(regs['sm_frame_bytes'], len(regs['sm_byte_freq']))
+        return {
+            'edges': regs['sm_edges'],
+            'lost': regs['sm_lost'],
+            'frames': regs['sm_frames'],
+            'bit': bits,
+            'deadtime': deadtimes,
+            'frame_bytes': regs['sm_frame_bytes'],
+            'frame_freq': regs['sm_frame_freq'],
+            'frame_rate': regs['sm_frame_rate'],
+            'byte_freqs': regs['sm_byte_freq'][:num_bytes]
+        }
+
+    def get_spi_clk_freqs(self, sm_buf=None) -> list:
         """Calculate frequency of captured timestamps.
+
+        Args:
+            sm_buf: The captured timestamps, read if None
         Returns:
             List of frequencies
         """
-        sm_buf = self.get_spi_sm_buf()
+        if sm_buf is None:
+            sm_buf = self.get_spi_sm_buf()
         timer_max = 0x10000
         pulses_per_byte = 8
         freqs = []
@@ -705,14 +1647,19 @@ class PhilipExtIf(PhilipBaseIf):
 
     def get_spi_clk_byte_stats(self, byte=None) -> dict:
         """Get stats for each clock pulse of the spi clk.
+
+        Only the bytes with timestamps in spi.sm_buf can be selected, the
+        registers are read once.
+
         Args:
             byte (int, None): The byte in the 8 bit calculation to use, if None
                 then use all bytes. Starting with index 0.
         Return:
             dict containing stats.
         """
-        num_bytes = self.get_spi_clk_frames()
-        bit_freqs = self.get_spi_clk_freqs()
+        sm_buf = self.get_spi_sm()['sm_buf']
+        num_bytes = int(len(sm_buf) / 8)
+        bit_freqs = self.get_spi_clk_freqs(sm_buf)
         if byte is not None:
             assert byte < num_bytes
             freqs_per_byte = 7
@@ -723,24 +1670,25 @@ class PhilipExtIf(PhilipBaseIf):
 
     def get_spi_clk_frame_stats(self) -> dict:
         """Get stats for byte in the spi frame.
+
+        The mean frequency of each byte is measured by the firmware, the
+        values are the bytes of the current or last frame.
+
         Return:
             dict containing stats.
         """
-        byte_freqs = []
-        for byte in range(self.get_spi_clk_frames()):
-            byte_freqs.append(self.get_spi_clk_byte_stats(byte)['mean'])
-        return self._get_stats(byte_freqs)
+        return self._get_stats(self.get_spi_clk_summary()['byte_freqs'])
 
     def get_spi_clk_deadtime_stats(self) -> dict:
         """Get stats for the time between spi bytes.
         Return:
             dict containing stats.
         """
-        sm_buf = self.get_spi_sm_buf()
+        sm_buf = self.get_spi_sm()['sm_buf']
         timer_max = 0x10000
         pulses_per_byte = 8
         deadtimes = []
-        for i in range(self.get_spi_clk_frames() - 1):
+        for i in range(int(len(sm_buf) / pulses_per_byte) - 1):
             offset = i * pulses_per_byte + pulses_per_byte
             deadtime_begin = offset - 1
             deadtime_end = offset
@@ -749,3 +1697,87 @@ class PhilipExtIf(PhilipBaseIf):
                 deadtime += timer_max
             deadtimes.append(deadtime)
         return self._get_stats(deadtimes)
+
+    def get_prof_stats(self) -> dict:
+        """Get the cycle count profiles of the firmware hot paths.
+
+        Only firmware built with PROFILE=1 records profiles, profiles of
+        functions that did not run are left out.
+
+        Return:
+            dict of function name to dict containing call_count, min_cycles,
+            max_cycles, mean_cycles and total_cycles.
+        """
+        stats = {}
+        for record in self.read_struct('prof.'):
+            if record['result'] != self.RESULT_SUCCESS:
+                raise ConnectionError(record)
+            name, val = next(iter(record['data'].items()))
+            index = int(name.split('[')[1].split(']')[0])
+            stats.setdefault(index, {})[name.split('.')[-1]] = val
+        return {self.PROF_NAMES[index]: entry
+                for index, entry in stats.items()
+                if index < len(self.PROF_NAMES) and entry['call_count']}
+
+    def get_debug_capture(self) -> list:
+        """Get how the edges of each DEBUG pin are captured.
+
+        With gpio[n].mode.capture the bluepill latches the edges with a
+        timer.  DEBUG2 is drained by dma, DEBUG0 and DEBUG1 take an
+        interrupt per edge so edges closer than the interrupt latency are
+        missed.  Unlike trace.dropped the lost edges do not include events
+        overwritten in the trace.
+
+        Return:
+            list with a dict for each DEBUG pin containing capture, dma and
+            the amount of lost edges since the pin was committed.
+        """
+        pins = []
+        for pin in range(3):
+            name = 'gpio[{}].'.format(pin)
+            pins.append({
+                'capture': self.read_reg(name + 'mode.capture')['data'],
+                'dma': self.read_reg(name + 'status.capture_dma')['data'],
+                'lost': self.read_reg(name + 'capture_lost')['data']})
+        return pins
+
+    def get_tmr_hist(self) -> dict:
+        """Get the histogram and stats of the DUT_IC tick differences.
+
+        The firmware collects them while draining the edges so millions of
+        edges can be characterised without reading the trace.  Committing
+        the tmr registers clears them.
+
+        Return:
+            dict containing the bucket counts, the lower bound of each
+            bucket, the differences below and above the buckets, the amount
+            of differences and their mean, variance and stdev in ticks.
+        """
+        regs = {}
+        for name in ('hist_start', 'hist_width', 'hist_numof', 'hist_below',
+                     'hist_above', 'stat_count', 'stat_ref', 'stat_sum',
+                     'stat_sum_sq'):
+            regs[name] = self.read_reg('tmr.' + name)['data']
+        buckets = []
+        if regs['hist_width'] and regs['hist_numof']:
+            buckets = self.read_reg('tmr.hist',
+                                    size=regs['hist_numof'])['data']
+        count = regs['stat_count']
+        stats = {
+            'buckets': buckets,
+            'bounds': [regs['hist_start'] + regs['hist_width'] * i
+                       for i in range(len(buckets))],
+            'below': regs['hist_below'],
+            'above': regs['hist_above'],
+            'num_values': count,
+            'mean': None,
+            'variance': 0,
+            'stdev': 0
+        }
+        if count:
+            stats['mean'] = regs['stat_ref'] + regs['stat_sum'] / count
+        if count > 1:
+            stats['variance'] = (regs['stat_sum_sq'] -
+                                 regs['stat_sum'] ** 2 / count) / (count - 1)
+            stats['stdev'] = stats['variance'] ** 0.5
+        return stats
@@ -70,6 +70,28 @@ class SerialDriver:
         logging.debug("Closing %s", self._dev.port)
         self._dev.close()
 
+    def get_baudrate(self):
+        """Get the baudrate of the connection
+
+        Returns:
+            int: The baudrate
+        """
+        return self._dev.baudrate
+
+    def set_baudrate(self, baudrate):
+        """Change the baudrate of the connection
+
+        Data that is still being written is sent at the previous baudrate.
+
+        Args:
+            baudrate(int): The new baudrate, also used when reconnecting
+        """
+        logging.debug("Changing baudrate to %r", baudrate)
+        self._dev.flush()
+        self._dev.baudrate = baudrate
+        if len(self._args) < 2:
+            self._kwargs['baudrate'] = baudrate
+
     def readline(self, timeout=None):
         """Read Line from Serial
 
@@ -99,14 +121,57 @@ class SerialDriver:
         logging.debug("Response: %s", response.replace('\n', ''))
         return response
 
-    def writeline(self, line):
+    def read(self, size, timeout=None):
+        """Read raw bytes from Serial
+
+        Reads a fixed amount of bytes without decoding.  Raises TimeoutError
+        exception if not all bytes are read.
+
+        Args:
+            size(int): Amount of bytes to read
+            timeout: Optional timeout value for command specific timeouts
+        Returns:
+            bytes: the data read
+        """
+        if timeout is None:
+            res_bytes = self._dev.read(size)
+        else:
+            default_timeout = self._dev.timeout
+            self._dev.timeout = timeout
+            res_bytes = self._dev.read(size)
+            self._dev.timeout = default_timeout
+        if len(res_bytes) != size:
+            # try to reconnect if timeout occurs
+            self.close()
+            self._connect(*self._args, **self._kwargs)
+            raise TimeoutError("Timeout during serial read")
+        logging.debug("Response: %r", res_bytes)
+        return res_bytes
+
+    def write(self, data, flush_input=True):
+        """Write raw bytes to Serial
+
+        Args:
+            data(bytes): bytes to send to the driver.
+            flush_input(bool): Discard unread input before writing, disable
+                               when responses of previous writes are pending
+        """
+        if flush_input:
+            self._dev.reset_input_buffer()
+        logging.debug("Sending: %r", data)
+        self._dev.write(data)
+
+    def writeline(self, line, flush_input=True):
         """Write Line to Serial
         Writes line to the serial port and adds a newline and encode to utf-8.
 
         Args:
             line(str): string or list of bytes to send to the driver.
+            flush_input(bool): Discard unread input before writing, disable
+                               when responses of previous writes are pending
         """
         # Clear the input buffer in case it junk data go in creating an offset
-        self._dev.reset_input_buffer()
+        if flush_input:
+            self._dev.reset_input_buffer()
         logging.debug("Sending: " + line)
         self._dev.write((line + '\n').encode('utf-8'))
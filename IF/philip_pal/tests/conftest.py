@@ -6,6 +6,18 @@ from pprint import pformat
 import pytest
 from philip_pal.philip_if import PhilipBaseIf
 from philip_pal.philip_if import PhilipExtIf
+from philip_pal.serial_driver import SerialDriver
+
+
+def pytest_addoption(parser):
+    """Adds the port option, such as the pty of the firmware simulation"""
+    parser.addoption("--port", default=None,
+                     help="Serial port of PHiLIP, defaults to the first one")
+
+
+def _port_kwargs(config):
+    port = config.getoption("--port")
+    return {} if port is None else {'port': port}
 
 
 def _try_reset(phil):
@@ -18,8 +30,8 @@ def _try_reset(phil):
 
 
 @pytest.fixture(scope="module")
-def phil_init_base():
-    phil = PhilipBaseIf()
+def phil_init_base(request):
+    phil = PhilipBaseIf(**_port_kwargs(request.config))
     yield phil
     phil.dev.close()
 
@@ -32,9 +44,11 @@ def phil_base(phil_init_base):
 
 
 @pytest.fixture(scope="module")
-def phil_init_ex():
-    phil = PhilipExtIf()
+def phil_init_ex(request):
+    phil = PhilipExtIf(**_port_kwargs(request.config))
     yield phil
+    # Leave the device at the baudrate other fixtures connect with
+    phil.set_if_baudrate(SerialDriver.DEFAULT_BAUDRATE)
     phil.dev.close()
 
 
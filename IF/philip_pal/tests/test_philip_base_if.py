@@ -51,6 +51,48 @@ def test_write_bytes_fail(phil_base):
         phil_base.write_bytes(0, 'xxx')
 
 
+def test_binary_read_write_bytes(phil_base):
+    """Tests the binary frame protocol matches the ASCII shell"""
+    ascii_data = phil_base.read_bytes(0, 16, True)['data']
+    phil_base.use_binary = True
+    try:
+        assert phil_base.read_bytes(0, 16, True)['data'] == ascii_data
+        assert phil_base.write_bytes(0, [9, 8, 7])['result'] == \
+            phil_base.RESULT_SUCCESS
+        assert phil_base.read_bytes(0, 3, True)['data'] == [9, 8, 7]
+        assert phil_base.read_bytes(99999)['result'] == \
+            phil_base.RESULT_ERROR
+        assert phil_base.write_bytes(99999, 0)['result'] == \
+            phil_base.RESULT_ERROR
+        assert phil_base.write_bytes(256, 0)['result'] == \
+            phil_base.RESULT_ERROR
+    finally:
+        phil_base.use_binary = False
+    assert phil_base.read_bytes(0, 3, True)['data'] == [9, 8, 7]
+
+
+def test_read_bytes_list(phil_base):
+    """Tests scatter-gather reads match single reads for both protocols"""
+    # The spans stay in the user registers so the data does not change
+    # between reads, each fits a single ASCII read but together they do not
+    spans = [(0, 4), (10, 2), (0, 2), (20, 200), (200, 56)]
+    expected = []
+    for index, size in spans:
+        expected += phil_base.read_bytes(index, size, True)['data']
+    cmd_info = phil_base.read_bytes_list(spans)
+    assert cmd_info['data'] == expected
+    assert len(cmd_info['cmd']) == 2
+    phil_base.use_binary = True
+    try:
+        assert phil_base.read_bytes_list(spans)['data'] == expected
+        assert phil_base.read_bytes_list([(99999, 1)])['result'] == \
+            phil_base.RESULT_ERROR
+    finally:
+        phil_base.use_binary = False
+    assert phil_base.read_bytes_list([(99999, 1)])['result'] == \
+        phil_base.RESULT_ERROR
+
+
 def test_read_bits_success(phil_base, regtest):
     """Tests various read bits and compares with regession"""
     phil_base.write_bytes(0, [0x91, 0x1F, 0, 0, 0, 0, 0, 1])
@@ -92,3 +134,26 @@ def test_base_functions(phil_base):
     assert phil_base.execute_changes()['result'] == phil_base.RESULT_SUCCESS
     assert phil_base.reset_mcu()['result'] == phil_base.RESULT_SUCCESS
     assert phil_base.get_version()['version']
+
+
+def test_send_and_parse_cmds(phil_base):
+    """Tests pipelined commands match the single command responses"""
+    phil_base.write_bytes(0, [1, 2, 3, 4])
+    cmds = ["rr {} 1".format(i) for i in range(4)] * 20 + ["xx", "ex"]
+    results = phil_base.send_and_parse_cmds(cmds)
+    assert [r['data'] for r in results[:4]] == [1, 2, 3, 4]
+    assert results[-2]['result'] == phil_base.RESULT_ERROR
+    assert results[-1]['result'] == phil_base.RESULT_SUCCESS
+    assert [r['cmd'] for r in results] == cmds
+
+
+def test_set_if_baudrate(phil_base):
+    """Tests switching the interface baudrate and back"""
+    boot_baudrate = phil_base.dev.get_baudrate()
+    assert phil_base.set_if_baudrate(10)['result'] == phil_base.RESULT_ERROR
+    assert phil_base.set_if_baudrate(1000000)['result'] == \
+        phil_base.RESULT_SUCCESS
+    assert phil_base.read_bytes(0, 8)['result'] == phil_base.RESULT_SUCCESS
+    assert phil_base.set_if_baudrate(boot_baudrate)['result'] == \
+        phil_base.RESULT_SUCCESS
+    assert phil_base.dev.get_baudrate() == boot_baudrate
@@ -1,6 +1,8 @@
 """
 Tests for the extended PHiLIP interface
 """
+import errno
+import time
 from conftest import _regtest
 
 
@@ -37,3 +39,82 @@ def test_philip_ext_write_reg(phil_ex):
             continue
         phil_ex.write_reg(cmd, 1)
         assert phil_ex.read_reg(cmd)['data'] == 1, "cmd={}".format(cmd)
+
+
+def test_if_baudrate_fallback(phil_ex):
+    """Tests the device falls back if the new baudrate is not confirmed"""
+    baudrate = phil_ex.dev.get_baudrate()
+    response = phil_ex.send_and_parse_cmd("baud {}".format(
+        phil_ex.DEFAULT_IF_BAUDRATE))
+    assert response['result'] == phil_ex.RESULT_SUCCESS
+    # Nothing is sent at the new baudrate so it is never confirmed
+    time.sleep(phil_ex.IF_BAUD_TIMEOUT + 0.5)
+    assert phil_ex.read_reg('sys.if_baud')['data'] == baudrate
+
+
+def test_write_permission(phil_ex):
+    """Tests writes are rejected if any byte lacks the write permission"""
+    user = phil_ex.mem_map['user_reg']
+    last = user['offset'] + user['total_size'] - 1
+    sys_sn = phil_ex.mem_map['sys.sn']
+    assert sys_sn['access'] == 0
+    sn_data = phil_ex.read_bytes(sys_sn['offset'], 4, True)['data']
+    response = phil_ex.write_bytes(sys_sn['offset'], [1, 2, 3, 4])
+    assert response['result'] == phil_ex.RESULT_ERROR
+    assert response['data'] == errno.EACCES
+    assert phil_ex.read_bytes(sys_sn['offset'], 4, True)['data'] == sn_data
+
+    # The binary frame writes the whole span or nothing
+    phil_ex.use_binary = True
+    try:
+        response = phil_ex.write_bytes(last, [0x5A, 0x5A])
+        assert response['data'] == errno.EACCES
+        assert phil_ex.read_bytes(last)['data'] != 0x5A
+        response = phil_ex.write_bytes(last - 1, [0x5A, 0x5A])
+        assert response['result'] == phil_ex.RESULT_SUCCESS
+        assert phil_ex.read_bytes(last - 1, 2, True)['data'] == [0x5A, 0x5A]
+    finally:
+        phil_ex.use_binary = False
+
+
+def test_spi_dma_mode(phil_ex):
+    """Tests the spi dma interface can be selected from the defaults"""
+    for response in phil_ex.start_spi_dma():
+        assert response['result'] == phil_ex.RESULT_SUCCESS
+    assert phil_ex.read_reg('spi.mode.init')['data'] == 1
+    assert phil_ex.read_reg('spi.mode.if_type')['data'] == 5
+    assert phil_ex.read_reg('tmr.mode.disable')['data'] == 1
+
+
+def test_read_struct(phil_ex):
+    """Tests the single request struct read matches reading each register"""
+    for struct_name in ['sys.', 'i2c.', 'user_reg']:
+        for record in phil_ex.read_struct(struct_name):
+            assert record['result'] == phil_ex.RESULT_SUCCESS
+            name, data = next(iter(record['data'].items()))
+            if 'VOLATILE' in phil_ex.mem_map[name]['flag']:
+                continue
+            assert phil_ex.read_reg(name)['data'] == data, name
+
+
+def test_trace_stream(phil_ex):
+    """Tests events are queued in the stream ring and drained"""
+    assert phil_ex.read_reg('trace.stream_size')['data'] > 0
+    phil_ex.start_trace_stream()
+    assert phil_ex.read_reg('trace.mode.stream')['data'] == 1
+    response = phil_ex.read_trace_stream()
+    assert response['result'] == phil_ex.RESULT_SUCCESS
+    assert response['overruns'] == 0
+    phil_ex.stop_trace_stream()
+    assert phil_ex.read_reg('trace.mode.stream')['data'] == 0
+
+
+def test_read_trace_since(phil_ex):
+    """Tests an incremental trace read only reports new events"""
+    response = phil_ex.read_trace()
+    assert response['result'] == phil_ex.RESULT_SUCCESS
+    assert sorted(response['loss']) == sorted(phil_ex.TRACE_SOURCES)
+    seqs = [event['seq'] for event in response['data']]
+    response = phil_ex.read_trace_since()
+    assert response['result'] == phil_ex.RESULT_SUCCESS
+    assert not set(event['seq'] for event in response['data']) & set(seqs)
@@ -1,8 +1,10 @@
 """Tests Static Methods for the PHiLIP inteface for philip pal
 
 """
+import struct
 import pytest
 from pprint import pformat
+from statistics import mean, stdev
 from philip_pal.philip_if import PhilipBaseIf
 from philip_pal.philip_if import PhilipExtIf
 
@@ -84,7 +86,262 @@ def test_mm_from_version(regtest, version_str):
     ([0, 1], 2, "uint16_t", [0x0100]),
     ([0, 1, 1, 1], 2, "uint16_t", [0x0100, 0x0101]),
     ([0, 0, 0, 1, 1, 0, 0, 1], 4, "uint32_t", [0x01000000, 0x01000001]),
-    ([1, 2, 3, 4, 5, 6, 7, 8], 8, "uint64_t", [0x0807060504030201])])
+    ([1, 2, 3, 4, 5, 6, 7, 8], 8, "uint64_t", [0x0807060504030201]),
+    ([0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF], 8, "int64_t", [-2])])
 def test_parse_array(data, type_size, prim_type, expected):
     """Tests parsing an array with various sizes"""
     assert PhilipExtIf()._parse_array(data, type_size, prim_type) == expected
+
+
+@pytest.mark.parametrize("seq, payload", [
+    (0, b'\x03'),
+    (1, b'\x01\x00\x00\x0a\x00'),
+    (255, b'\x02\x00\x00' + bytes(range(256)))])
+def test_frame_round_trip(seq, payload):
+    """Tests encoding and decoding binary frames"""
+    frame = PhilipBaseIf._encode_frame(seq, payload)
+    assert frame[0] == PhilipBaseIf.BIN_SOF
+    assert PhilipBaseIf._decode_frame(frame) == (seq, payload)
+
+
+def test_decode_frame_fail():
+    """Tests corrupted binary frames are rejected"""
+    frame = bytearray(PhilipBaseIf._encode_frame(1, b'\x01\x00\x00\x01\x00'))
+    with pytest.raises(ValueError):
+        PhilipBaseIf._decode_frame(frame[:-1])
+    frame[5] ^= 0xFF
+    with pytest.raises(ValueError):
+        PhilipBaseIf._decode_frame(frame)
+
+
+def test_trace_records():
+    """Tests decoding dumped trace records to events"""
+    phil = PhilipExtIf()
+    phil._sys_clock = 1000
+    data = PhilipBaseIf.TRACE_RECORD.pack(1, 0, 1, 500, 7)
+    data += PhilipBaseIf.TRACE_RECORD.pack(4, 2, 0, 500, 8)
+    events = [phil._trace_event(tick_div, source, tick, value, seq)
+              for source, tick_div, value, tick, seq in
+              PhilipBaseIf.TRACE_RECORD.iter_unpack(data)]
+    assert events == [{'time': 0.5, 'source': 'DEBUG0', 'event': 'RISING',
+                       'seq': 7},
+                      {'time': 2.0, 'source': 'DUT_IC', 'event': 'FALLING',
+                       'seq': 8}]
+
+
+def test_trace_time_ns():
+    """Tests 64 bit ticks convert to exact ns after the 32 bit wrap"""
+    phil = PhilipExtIf()
+    phil._sys_clock = 72000000
+    # One hour and one tick, a 32 bit tick wraps after about a minute
+    tick = 3600 * 72000000 + 1
+    event = phil._trace_event(0, 1, tick, 1, to_ns=True)
+    assert event['time'] == 3600000000013
+    event = phil._trace_event(2, 1, tick, 1, to_ns=True)
+    assert event['time'] == 4 * 3600000000000 + 55
+
+
+def test_trace_lost():
+    """Tests counting missing sequence numbers across a wrap"""
+    def _events(seqs):
+        return [{'seq': seq & 0xFFFFFFFF} for seq in seqs]
+
+    lost = PhilipExtIf._trace_lost
+    assert lost([]) == (0, None)
+    assert lost(_events([5, 6, 9])) == (2, 10)
+    assert lost(_events([-2, -1, 1])) == (1, 2)
+    assert lost(_events([3, 4]), 1) == (2, 5)
+    assert lost([], 1) == (0, 1)
+
+
+def test_read_trace_since():
+    """Tests incremental reads only transfer the new trace slots"""
+    phil = PhilipExtIf()
+    phil.mem_map = phil.mm_from_version('2.1.0')
+    phil._sys_clock = 1000
+    mem = bytearray(phil.mem_map['trace.dropped']['offset'] + 16)
+    reads = []
+
+    def _store(seq):
+        index = int.from_bytes(mem[phil.mem_map['trace.index']['offset']:
+                                   phil.mem_map['trace.index']['offset'] + 4],
+                               'little')
+        for name, value in (('trace.source', 1), ('trace.tick', seq),
+                            ('trace.seq', seq), ('trace.value', 1)):
+            cmd = phil.mem_map[name]
+            offset = cmd['offset'] + index * cmd['type_size']
+            mem[offset:offset + cmd['type_size']] = \
+                value.to_bytes(cmd['type_size'], 'little')
+        for name, value in (('trace.index', (index + 1) % 128),
+                            ('trace.count', seq + 1)):
+            offset = phil.mem_map[name]['offset']
+            mem[offset:offset + 4] = value.to_bytes(4, 'little')
+
+    def _read_bytes_list(spans, timeout=None):
+        reads.append(spans)
+        data = []
+        for index, size in spans:
+            data += list(mem[index:index + size])
+        return {'cmd': 'rrs', 'data': data, 'result': phil.RESULT_SUCCESS}
+
+    def _read_reg(cmd_name, offset=0, size=None, timeout=None):
+        cmd = phil.mem_map[cmd_name]
+        index = cmd['offset'] + offset * cmd['type_size']
+        data = mem[index:index + (size or 128) * cmd['type_size']]
+        return {'data': phil._parse_array(data, cmd['type_size'],
+                                          cmd['type'])}
+
+    phil.read_bytes_list = _read_bytes_list
+    phil.read_reg = _read_reg
+    for seq in range(126):
+        _store(seq)
+    assert len(phil.read_trace_since()['data']) == 126
+    for seq in range(126, 130):
+        _store(seq)
+    reads.clear()
+    response = phil.read_trace_since()
+    assert [event['seq'] for event in response['data']] == \
+        [126, 127, 128, 129]
+    assert response['lost'] == 0
+    # The cursor and then both wrapped ranges of the 6 arrays
+    assert len(reads) == 2 and len(reads[1]) == 12
+    reads.clear()
+    assert phil.read_trace_since()['data'] == []
+    assert len(reads) == 1
+    for seq in range(130, 400):
+        _store(seq)
+    response = phil.read_trace_since()
+    assert len(response['data']) == 128
+    assert response['lost'] == 270 - 128
+
+
+def test_drain_trace():
+    """Tests drained events are acknowledged and survive a lost response"""
+    phil = PhilipBaseIf()
+    queued = [PhilipBaseIf.TRACE_RECORD.pack(1, 0, i & 1, i, i)
+              for i in range(300)]
+    state = {'pos': 0, 'fail': True}
+
+    def _send_frame(payload, timeout):
+        ack = struct.unpack_from('<H', payload, 1)[0]
+        del queued[:ack - state['pos']]
+        state['pos'] = ack
+        if state['fail']:
+            state['fail'] = False
+            raise TimeoutError
+        data = b''.join(queued[:100])
+        return bytes([payload[0], 0]) + \
+            struct.pack('<HH', ack, len(queued)) + data
+
+    phil._send_frame = _send_frame
+    assert phil.drain_trace()['result'] == phil.RESULT_TIMEOUT
+    cmd_info = phil.drain_trace()
+    assert cmd_info['result'] == phil.RESULT_SUCCESS
+    assert [tick for _, _, tick, _, _ in cmd_info['data']] == \
+        list(range(300))
+    assert cmd_info['pending'] == 0
+    assert phil.drain_trace()['data'] == []
+
+
+def test_tmr_hist():
+    """Tests the mean and variance from the relative sums of DUT_IC"""
+    diffs = [1000, 990, 1012, 1003, 995]
+    regs = {'tmr.hist_start': 980, 'tmr.hist_width': 10,
+            'tmr.hist_numof': 3, 'tmr.hist_below': 0, 'tmr.hist_above': 1,
+            'tmr.hist': [0, 3, 1], 'tmr.stat_count': len(diffs),
+            'tmr.stat_ref': diffs[0],
+            'tmr.stat_sum': sum(d - diffs[0] for d in diffs),
+            'tmr.stat_sum_sq': sum((d - diffs[0]) ** 2 for d in diffs)}
+
+    def _read_reg(cmd_name, offset=0, size=None, timeout=None):
+        if size is not None:
+            return {'data': regs[cmd_name][:size]}
+        return {'data': regs[cmd_name]}
+
+    phil = PhilipExtIf()
+    phil.read_reg = _read_reg
+    stats = phil.get_tmr_hist()
+    assert stats['bounds'] == [980, 990, 1000]
+    assert stats['buckets'] == [0, 3, 1]
+    assert stats['num_values'] == 5
+    assert stats['mean'] == pytest.approx(mean(diffs))
+    assert stats['stdev'] == pytest.approx(stdev(diffs))
+
+
+def test_debug_capture():
+    """Tests the capture registers of each DEBUG pin are reported"""
+    regs = {'gpio[0].mode.capture': 1, 'gpio[0].status.capture_dma': 0,
+            'gpio[0].capture_lost': 12,
+            'gpio[1].mode.capture': 0, 'gpio[1].status.capture_dma': 0,
+            'gpio[1].capture_lost': 0,
+            'gpio[2].mode.capture': 1, 'gpio[2].status.capture_dma': 1,
+            'gpio[2].capture_lost': 3}
+
+    def _read_reg(cmd_name, offset=0, size=None, timeout=None):
+        return {'data': regs[cmd_name]}
+
+    phil = PhilipExtIf()
+    phil.read_reg = _read_reg
+    assert phil.get_debug_capture() == [
+        {'capture': 1, 'dma': 0, 'lost': 12},
+        {'capture': 0, 'dma': 0, 'lost': 0},
+        {'capture': 1, 'dma': 1, 'lost': 3}]
+
+
+def test_spi_clk_summary():
+    """Tests the spi clock stats come from a single struct read"""
+    sm_buf = [10 * i for i in range(8)] + [100 + 10 * i for i in range(8)]
+    regs = {'spi.sm_buf': sm_buf + [0, 0],
+            'spi.sm_edges': 16, 'spi.sm_lost': 0, 'spi.sm_frames': 1,
+            'spi.sm_bit_count': 8, 'spi.sm_bit_min': 10,
+            'spi.sm_bit_max': 30, 'spi.sm_bit_sum': 100,
+            'spi.sm_dead_count': 1, 'spi.sm_dead_min': 30,
+            'spi.sm_dead_max': 30, 'spi.sm_dead_sum': 30,
+            'spi.sm_frame_bytes': 2, 'spi.sm_frame_freq': 8000000,
+            'spi.sm_frame_rate': 7200000,
+            'spi.sm_byte_freq': [7200000, 0, 5]}
+    reads = []
+
+    def _read_struct(cmd_name, data_has_name=True, timeout=None):
+        reads.append(cmd_name)
+        return [{'data': {name: val}, 'result': PhilipExtIf.RESULT_SUCCESS}
+                for name, val in regs.items()]
+
+    phil = PhilipExtIf()
+    phil.read_struct = _read_struct
+    phil._sys_clock = 72000000
+    summary = phil.get_spi_clk_summary()
+    assert reads == ['spi.sm_']
+    assert summary['bit']['mean'] == 5760000
+    assert summary['bit']['min'] == 2400000
+    assert summary['bit']['max'] == 7200000
+    assert summary['deadtime']['mean'] == 30
+    assert summary['byte_freqs'] == [7200000, 0]
+    assert phil.get_spi_sm()['sm_buf'] == sm_buf
+    assert phil.get_spi_clk_deadtime_stats()['values'] == [30]
+    assert phil.get_spi_clk_frame_stats()['values'] == [7200000, 0]
+
+
+def test_drain_spi_sniff():
+    """Tests sniffed frames are unpacked and acknowledged"""
+    phil = PhilipBaseIf()
+    queued = [PhilipBaseIf.SPI_SNIFF_HDR.pack(i, 10, 2, 2, 0) +
+              bytes([i, i + 1, 0xFF - i, 0xFE - i]) for i in range(30)]
+    state = {'pos': 0}
+
+    def _send_frame(payload, timeout):
+        ack = struct.unpack_from('<H', payload, 1)[0]
+        del queued[:ack - state['pos']]
+        state['pos'] = ack
+        data = b''.join(queued[:20])
+        return bytes([payload[0], 0]) + \
+            struct.pack('<HH', ack, len(queued)) + data
+
+    phil._send_frame = _send_frame
+    cmd_info = phil.drain_spi_sniff()
+    assert cmd_info['result'] == phil.RESULT_SUCCESS
+    assert [frame['tick'] for frame in cmd_info['data']] == list(range(30))
+    assert cmd_info['data'][3]['mosi'] == [3, 4]
+    assert cmd_info['data'][3]['miso'] == [0xFC, 0xFB]
+    assert cmd_info['pending'] == 0
+    assert phil.drain_spi_sniff()['data'] == []
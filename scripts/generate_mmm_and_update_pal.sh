@@ -2,6 +2,7 @@
 PHILIP_BASE="$( cd "$( dirname "${BASH_SOURCE[1]}" )" >/dev/null 2>&1 && pwd )"
 echo $PHILIP_BASE
 generate_map -cfgp $PHILIP_BASE/FW/MMM/PHiLIP_config.json -odir $PHILIP_BASE/FW/MMM/ -ocsv $PHILIP_BASE/IF/philip_pal/philip_pal/mem_map/ -ocfg $PHILIP_BASE/FW/MMM/PHiLIP_config.json
+python3 $PHILIP_BASE/scripts/generate_write_map.py $PHILIP_BASE/FW/MMM
 cd $PHILIP_BASE/IF/philip_pal
 
 python3 setup.py install --force --user
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Generates the write permission bitmaps of the memory map
+
+The memory map manager emits one access byte per register byte. The firmware
+only needs the write permission of the interface and the peripheral so this
+packs them into one bit per register byte for each access level.
+"""
+import argparse
+import os
+import re
+
+LEVELS = ('interface', 'peripheral')
+WORDS_PER_LINE = 4
+
+
+def read_access(path):
+    """Returns the access bytes of a generated mm_access_<map>.c in order"""
+    with open(path) as f:
+        return [int(x) for x in re.findall(r'\{\.data=(\d+)\}', f.read())]
+
+
+def pack_level(access, level):
+    """Packs the write permission bit of a level into 32 bit words"""
+    words = [0] * ((len(access) + 31) // 32)
+    for i, acc in enumerate(access):
+        if acc & (1 << level):
+            words[i // 32] |= 1 << (i % 32)
+    return words
+
+
+def banner(title):
+    start = '/* %s ' % title
+    return start + '*' * (78 - len(start)) + '/\n'
+
+
+def header(fname, details):
+    return ('/**\n'
+            ' ' + '*' * 78 + '\n'
+            ' * @addtogroup philip_map_mmm\n'
+            ' * @{\n'
+            ' * @file      %s\n'
+            ' *\n'
+            ' * @details   %s\n'
+            ' ' + '*' * 78 + '\n'
+            ' */\n') % (fname, details)
+
+
+def gen_h(mname, size, words, details):
+    guard = 'MM_WRITE_MAP_%s_H' % mname.upper()
+    prefix = 'MM_WRITE_MAP_%s' % mname.upper()
+    s = header('mm_write_map_%s.h' % mname, details)
+    s += '#ifndef %s\n#define %s\n\n' % (guard, guard)
+    s += '#ifdef __cplusplus\nextern "C"\n{\n#endif\n\n'
+    s += banner('includes')
+    s += '#include <stdint.h>\n\n'
+    s += banner('defs')
+    s += '#define %s_SIZE %d /** Register bytes covered **/\n' % (prefix,
+                                                                   size)
+    s += '#define %s_LEVELS %d /** Bitmaps, one per access level **/\n' % (
+        prefix, len(LEVELS))
+    s += '#define %s_WORDS %d /** Words of a bitmap **/\n\n' % (prefix,
+                                                                 words)
+    s += banner('variables')
+    s += ('/** @brief  Write permission of each register byte, index 0 is '
+          'the interface\n *          and index 1 the peripheral */\n')
+    s += 'extern const uint32_t mm_write_map_%s[%s_LEVELS][%s_WORDS];\n\n' % (
+        mname, prefix, prefix)
+    s += '#ifdef __cplusplus\n}\n#endif\n\n'
+    s += '#endif /* %s */\n/** @} **/' % guard
+    return s
+
+
+def gen_c(mname, maps, details):
+    prefix = 'MM_WRITE_MAP_%s' % mname.upper()
+    s = header('mm_write_map_%s.c' % mname, details)
+    s += '\n' + banner('includes')
+    s += '#include <stdint.h>\n\n'
+    s += '#include "mm_write_map_%s.h"\n\n' % mname
+    s += banner('variables')
+    s += 'const uint32_t mm_write_map_%s[%s_LEVELS][%s_WORDS] =\n{\n' % (
+        mname, prefix, prefix)
+    for name, words in zip(LEVELS, maps):
+        s += '{  /* %s */\n' % name
+        for i in range(0, len(words), WORDS_PER_LINE):
+            s += ''.join('0x%08X, ' % w
+                         for w in words[i:i + WORDS_PER_LINE]).rstrip()
+            s += '\n'
+        s += '},\n'
+    s += '};\n'
+    return s
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('mmm_dir', help='directory of the generated files')
+    parser.add_argument('--map', default='philip_map', help='name of the map')
+    args = parser.parse_args()
+
+    src = 'mm_access_%s.c' % args.map
+    access = read_access(os.path.join(args.mmm_dir, src))
+    maps = [pack_level(access, level) for level in range(len(LEVELS))]
+    details = 'Generated by generate_write_map.py from %s' % src
+    for fname, text in (
+            ('mm_write_map_%s.h' % args.map,
+             gen_h(args.map, len(access), len(maps[0]), details)),
+            ('mm_write_map_%s.c' % args.map,
+             gen_c(args.map, maps, details))):
+        with open(os.path.join(args.mmm_dir, fname), 'w') as f:
+            f.write(text)
+
+
+if __name__ == '__main__':
+    main()